@@ -6,16 +6,29 @@
  */
 
 #include "TransformPublisher.h"
+#include <boost/make_shared.hpp>
 
 using namespace std;
 
 namespace rct {
 
+rsc::logging::LoggerPtr TransformPublisher::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformPublisher");
+
+// interval of the timer, also the minimum time an edge must be quiet before
+// its last suppressed transform is sent
+static const boost::posix_time::time_duration timerPeriod = boost::posix_time::milliseconds(50);
+
 TransformPublisher::TransformPublisher(const TransformCommunicator::Ptr &comm, const TransformerConfig& conf) :
-		comm(comm), config(conf) {
+		comm(comm), config(conf), suppressed(0), timerRunning(false) {
+	if (config.hasPublishPolicies()) {
+		timerRunning = true;
+		timer = boost::thread(&TransformPublisher::runTimer, this);
+	}
 }
 
 TransformPublisher::~TransformPublisher() {
+	stopTimer();
 }
 
 void TransformPublisher::printContents(std::ostream& stream) const {
@@ -24,6 +37,9 @@ void TransformPublisher::printContents(std::ostream& stream) const {
 	stream << "}, config = {";
 	config.print(stream);
 	stream << "}";
+	if (config.hasPublishPolicies()) {
+		stream << ", suppressed = " << getSuppressed();
+	}
 }
 
 TransformerConfig TransformPublisher::getConfig() const {
@@ -35,14 +51,166 @@ string TransformPublisher::getAuthorityName() const {
 }
 
 bool TransformPublisher::sendTransform(const Transform& transform, TransformType type) {
+	if (type == DYNAMIC && config.hasPublishPolicies() && !isDue(transform)) {
+		return true;
+	}
 	return comm->sendTransform(transform, type);
 }
 
 bool TransformPublisher::sendTransform(const std::vector<Transform>& transforms, TransformType type) {
-	return comm->sendTransform(transforms, type);
+	if (type != DYNAMIC || !config.hasPublishPolicies()) {
+		return comm->sendTransform(transforms, type);
+	}
+
+	std::vector<Transform> due;
+	due.reserve(transforms.size());
+	std::vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		if (isDue(*it)) {
+			due.push_back(*it);
+		}
+	}
+	if (due.empty()) {
+		return true;
+	}
+	return comm->sendTransform(due, type);
+}
+
+bool TransformPublisher::isDue(const Transform& transform) {
+	boost::mutex::scoped_lock lock(mutex);
+
+	pair<string, string> key(transform.getFrameParent(), transform.getFrameChild());
+	boost::shared_ptr<EdgeState>& state = edges[key];
+	if (!state) {
+		state = boost::make_shared<EdgeState>();
+		state->policy = config.getPublishPolicy(transform.getFrameChild());
+		state->sent = false;
+		state->pending = false;
+	}
+
+	const PublishPolicy& policy = state->policy;
+	const boost::posix_time::ptime& time = transform.getTime();
+	const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+	state->receivedAt = now;
+
+	// the first transform, time going backwards (e.g. a restarted source)
+	// and transforms without a time stamp are always sent
+	bool due = !state->sent || time.is_special() || state->lastSent.is_special()
+			|| time < state->lastSent;
+	if (!due) {
+		boost::posix_time::time_duration elapsed = time - state->lastSent;
+		if (policy.maxRate > 0
+				&& elapsed.total_microseconds() < 1000000.0 / policy.maxRate) {
+			suppressed++;
+			state->latest = transform;
+			state->pending = true;
+			return false;
+		}
+
+		if (!policy.keepalive.is_special() && elapsed >= policy.keepalive) {
+			due = true;
+		} else if (policy.translationThreshold > 0 || policy.rotationThreshold > 0) {
+			Eigen::Affine3d delta = state->lastTransform.inverse() * transform.getTransform();
+			double translation = delta.translation().norm();
+			double rotation = Eigen::AngleAxisd(delta.rotation()).angle();
+			due = (policy.translationThreshold > 0 && translation >= policy.translationThreshold)
+					|| (policy.rotationThreshold > 0 && rotation >= policy.rotationThreshold);
+		} else {
+			due = true;
+		}
+	}
+
+	if (!due) {
+		suppressed++;
+		state->latest = transform;
+		state->pending = true;
+		return false;
+	}
+	markSent(*state, transform, now);
+	return true;
+}
+
+void TransformPublisher::markSent(EdgeState& state, const Transform& transform,
+		const boost::posix_time::ptime& now) {
+	state.sent = true;
+	state.lastSent = transform.getTime();
+	state.lastTransform = transform.getTransform();
+	state.latest = transform;
+	state.pending = false;
+	state.sentAt = now;
+}
+
+void TransformPublisher::runTimer() {
+	boost::mutex::scoped_lock lock(mutex);
+	while (timerRunning) {
+		timerCondition.timed_wait(lock, timerPeriod);
+		if (!timerRunning) {
+			break;
+		}
+
+		const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		vector<Transform> due;
+		map<pair<string, string>, boost::shared_ptr<EdgeState> >::iterator it;
+		for (it = edges.begin(); it != edges.end(); ++it) {
+			EdgeState& state = *it->second;
+			if (!state.sent) {
+				continue;
+			}
+			const PublishPolicy& policy = state.policy;
+			if (state.pending) {
+				// the source went quiet, receivers get its final state
+				boost::posix_time::time_duration quiet = timerPeriod;
+				if (policy.maxRate > 0) {
+					quiet = std::max<boost::posix_time::time_duration>(quiet,
+							boost::posix_time::microseconds(
+									boost::int64_t(1000000.0 / policy.maxRate)));
+				}
+				if (now - state.receivedAt >= quiet) {
+					due.push_back(state.latest);
+					markSent(state, state.latest, now);
+				}
+			} else if (!policy.keepalive.is_special() && now - state.sentAt >= policy.keepalive) {
+				// no new transform, repeat the latest one
+				due.push_back(state.latest);
+				state.sentAt = now;
+			}
+		}
+		if (due.empty()) {
+			continue;
+		}
+
+		lock.unlock();
+		try {
+			comm->sendTransform(due, DYNAMIC);
+		} catch (std::exception &e) {
+			RSCERROR(logger, "Cannot send pending transforms. Reason: " << e.what());
+		}
+		lock.lock();
+	}
+}
+
+void TransformPublisher::stopTimer() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		timerRunning = false;
+	}
+	timerCondition.notify_all();
+	if (timer.joinable()) {
+		timer.join();
+	}
+}
+
+unsigned long TransformPublisher::getSuppressed() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return suppressed;
+}
+
+void TransformPublisher::flush() {
+	comm->flush();
 }
 
 void TransformPublisher::shutdown() {
+	stopTimer();
 	comm->shutdown();
 }
 
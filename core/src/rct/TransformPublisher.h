@@ -12,6 +12,7 @@
 #include "TransformerConfig.h"
 #include "impl/TransformCommunicator.h"
 #include "impl/TransformerCore.h"
+#include <rsc/logging/Logger.h>
 #include <Eigen/Geometry>
 #include <string>
 #include <boost/integer.hpp>
@@ -43,14 +44,55 @@ public:
 	 */
 	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
 
+	/** \brief Send transforms held back by an aggregation window right away */
+	void flush();
+
 	void printContents(std::ostream& stream) const;
 	TransformerConfig getConfig() const;
 	std::string getAuthorityName() const;
 	void shutdown();
+
+	/** \brief Number of dynamic transforms not sent because of the publish policies */
+	unsigned long getSuppressed() const;
 private:
 
+	class EdgeState {
+	public:
+		PublishPolicy policy;
+		bool sent;
+		boost::posix_time::ptime lastSent;
+		Eigen::Affine3d lastTransform;
+		// the latest transform of the edge, not sent yet if pending
+		Transform latest;
+		bool pending;
+		// wall clock times of the last send and the last transform
+		boost::posix_time::ptime sentAt;
+		boost::posix_time::ptime receivedAt;
+		EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+	};
+
 	TransformCommunicator::Ptr comm;
 	TransformerConfig config;
+
+	// per edge state of the publish policies
+	mutable boost::mutex mutex;
+	std::map<std::pair<std::string, std::string>, boost::shared_ptr<EdgeState> > edges;
+	unsigned long suppressed;
+
+	// Sends the last suppressed transform of edges gone quiet and the
+	// keepalive of edges without new transforms. Only runs with publish
+	// policies.
+	boost::thread timer;
+	boost::condition_variable timerCondition;
+	bool timerRunning;
+
+	static rsc::logging::LoggerPtr logger;
+
+	bool isDue(const Transform& transform);
+	void markSent(EdgeState& state, const Transform& transform,
+			const boost::posix_time::ptime& now);
+	void runTimer();
+	void stopTimer();
 };
 
 } /* namespace rct */
@@ -12,8 +12,11 @@ using namespace std;
 namespace rct {
 
 TransformReceiver::TransformReceiver(const TransformerCore::Ptr &core,
-		const TransformCommunicator::Ptr &comm, const TransformerConfig& conf) :
-		core(core), comm(comm), config(conf) {
+		const TransformCommunicator::Ptr &comm, const TransformerConfig& conf,
+		const TransformLookupCache::Ptr &lookupCache,
+		const TransformInterestFilter::Ptr &interestFilter) :
+		core(core), comm(comm), config(conf), lookupCache(lookupCache), interestFilter(
+				interestFilter) {
 }
 
 TransformReceiver::~TransformReceiver() {
@@ -22,8 +25,18 @@ TransformReceiver::~TransformReceiver() {
 void TransformReceiver::printContents(std::ostream& stream) const {
 	stream << "core = {";
 	core->printContents(stream);
-	stream << "}, communicator = {";
-	comm->printContents(stream);
+	if (comm) {
+		stream << "}, communicator = {";
+		comm->printContents(stream);
+	}
+	if (lookupCache) {
+		stream << "}, lookupCache = {";
+		lookupCache->printContents(stream);
+	}
+	if (interestFilter) {
+		stream << "}, interestFilter = {";
+		interestFilter->printContents(stream);
+	}
 	stream << "}, config = {";
 	config.print(stream);
 	stream << "}";
@@ -34,28 +47,43 @@ TransformerConfig TransformReceiver::getConfig() const {
 }
 
 string TransformReceiver::getAuthorityName() const {
+	if (!comm) {
+		return "";
+	}
 	return comm->getAuthorityName();
 }
 
 Transform TransformReceiver::lookupTransform(const std::string& target_frame,
 		const std::string& source_frame, const boost::posix_time::ptime& time) const {
+	learn(target_frame);
+	learn(source_frame);
+	if (lookupCache) {
+		return lookupCache->lookupTransform(target_frame, source_frame, time);
+	}
 	return core->lookupTransform(target_frame, source_frame, time);
 }
 
 Transform TransformReceiver::lookupTransform(const std::string& target_frame,
 		const boost::posix_time::ptime& target_time, const std::string& source_frame,
 		const boost::posix_time::ptime& source_time, const std::string& fixed_frame) const {
+	learn(target_frame);
+	learn(source_frame);
+	learn(fixed_frame);
 	return core->lookupTransform(target_frame, target_time, source_frame, source_time, fixed_frame);
 }
 
 TransformReceiver::FuturePtr TransformReceiver::requestTransform(const std::string& target_frame,
 		const std::string& source_frame, const boost::posix_time::ptime& time) {
+	learn(target_frame);
+	learn(source_frame);
 	return core->requestTransform(target_frame, source_frame, time);
 }
 
 bool TransformReceiver::canTransform(const std::string& target_frame,
 		const std::string& source_frame, const boost::posix_time::ptime& time,
 		std::string* error_msg) const {
+	learn(target_frame);
+	learn(source_frame);
 	return core->canTransform(target_frame, source_frame, time, error_msg);
 }
 
@@ -63,6 +91,9 @@ bool TransformReceiver::canTransform(const std::string& target_frame,
 		const boost::posix_time::ptime& target_time, const std::string& source_frame,
 		const boost::posix_time::ptime& source_time, const std::string& fixed_frame,
 		std::string* error_msg) const {
+	learn(target_frame);
+	learn(source_frame);
+	learn(fixed_frame);
 	return core->canTransform(target_frame, target_time, source_frame, source_time, fixed_frame,
 			error_msg);
 }
@@ -71,8 +102,23 @@ TransformerCore::ConstPtr TransformReceiver::getCore() const {
 	return core;
 }
 
+TransformLookupCache::Statistics TransformReceiver::getLookupCacheStatistics() const {
+	if (lookupCache) {
+		return lookupCache->getStatistics();
+	}
+	return TransformLookupCache::Statistics();
+}
+
+void TransformReceiver::learn(const string& frame) const {
+	if (interestFilter && config.isInterestLearning()) {
+		interestFilter->addFrame(frame);
+	}
+}
+
 void TransformReceiver::shutdown() {
-	comm->shutdown();
+	if (comm) {
+		comm->shutdown();
+	}
 }
 
 }  // namespace rct
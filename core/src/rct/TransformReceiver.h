@@ -12,6 +12,8 @@
 #include "TransformerConfig.h"
 #include "impl/TransformCommunicator.h"
 #include "impl/TransformerCore.h"
+#include "impl/TransformLookupCache.h"
+#include "impl/TransformInterestFilter.h"
 #include <Eigen/Geometry>
 #include <string>
 #include <boost/integer.hpp>
@@ -26,7 +28,9 @@ public:
 	typedef boost::shared_ptr<FutureType> FuturePtr;
 
 	TransformReceiver(const TransformerCore::Ptr &core, const TransformCommunicator::Ptr &comm,
-			const TransformerConfig &conf = TransformerConfig());
+			const TransformerConfig &conf = TransformerConfig(),
+			const TransformLookupCache::Ptr &lookupCache = TransformLookupCache::Ptr(),
+			const TransformInterestFilter::Ptr &interestFilter = TransformInterestFilter::Ptr());
 	virtual ~TransformReceiver();
 
 	/** \brief Get the transform between two frames by frame ID.
@@ -87,6 +91,9 @@ public:
 
 	TransformerCore::ConstPtr getCore() const;
 
+	/** \brief Hit-rate statistics of the lookup cache. All zero if the cache is disabled. */
+	TransformLookupCache::Statistics getLookupCacheStatistics() const;
+
 	void printContents(std::ostream& stream) const;
 	TransformerConfig getConfig() const;
 	std::string getAuthorityName() const;
@@ -96,6 +103,10 @@ private:
 	TransformCommunicator::Ptr comm;
 	TransformerCore::Ptr core;
 	TransformerConfig config;
+	TransformLookupCache::Ptr lookupCache;
+	TransformInterestFilter::Ptr interestFilter;
+
+	void learn(const std::string& frame) const;
 };
 
 } /* namespace rct */
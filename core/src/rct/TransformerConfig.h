@@ -11,15 +11,62 @@
 #include <rsc/runtime/Printable.h>
 #include <rsc/runtime/Properties.h>
 #include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
+#include <map>
+#include <vector>
 
 namespace rct {
 
+/**
+ * Limits how often a TransformPublisher forwards dynamic transforms of an
+ * edge. All durations refer to the transform time stamps. Without thresholds,
+ * every transform passing the rate limit is sent. With thresholds, a
+ * transform is sent if it exceeds any of them or the keepalive is due.
+ *
+ * The last suppressed transform of an edge is sent once the edge is quiet
+ * for the rate interval, so receivers get the final state of a source that
+ * stopped. Without new transforms, the latest one is repeated every
+ * keepalive (wall clock).
+ */
+class PublishPolicy: public rsc::runtime::Printable {
+public:
+	PublishPolicy() :
+			maxRate(0), translationThreshold(0), rotationThreshold(0), keepalive(
+					boost::posix_time::not_a_date_time) {
+	}
+	virtual ~PublishPolicy() {
+	}
+
+	/** \brief Maximum number of transforms per second. 0 means unlimited. */
+	double maxRate;
+	/** \brief Minimum change of the translation in meters since the last sent transform */
+	double translationThreshold;
+	/** \brief Minimum change of the rotation in radians since the last sent transform */
+	double rotationThreshold;
+	/** \brief A transform is sent at least this often, even without change. Not a
+	 * date time disables the keepalive. */
+	boost::posix_time::time_duration keepalive;
+
+	bool isActive() const {
+		return maxRate > 0 || translationThreshold > 0 || rotationThreshold > 0;
+	}
+
+	void printContents(std::ostream& stream) const {
+		stream << "maxRate = " << maxRate;
+		stream << ", translationThreshold = " << translationThreshold;
+		stream << ", rotationThreshold = " << rotationThreshold;
+		stream << ", keepalive = " << keepalive;
+	}
+};
+
 class TransformerConfig: public rsc::config::OptionHandler,
 		public rsc::runtime::Printable {
 public:
 
 	enum CommunicatorType {
-		AUTO, RSB, ROS
+		AUTO, RSB, ROS, SHM, LOOPBACK, REPLAY
 	};
 
 	static std::string typeToString(CommunicatorType type) {
@@ -30,14 +77,85 @@ public:
 			return "RSB";
 		case ROS:
 			return "ROS";
+		case SHM:
+			return "SHM";
+		case LOOPBACK:
+			return "LOOPBACK";
+		case REPLAY:
+			return "REPLAY";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	/**
+	 * Built-in implementations of the core storing the transforms of a
+	 * receiver. CORE_CUSTOM names any other backend registered with the
+	 * factory, see getCoreName().
+	 */
+	enum CoreType {
+		CORE_TF2, CORE_SHM, CORE_OFFLINE, CORE_CUSTOM
+	};
+
+	static std::string coreTypeToString(CoreType type) {
+		switch (type) {
+		case CORE_TF2:
+			return "TF2";
+		case CORE_SHM:
+			return "SHM";
+		case CORE_OFFLINE:
+			return "OFFLINE";
+		case CORE_CUSTOM:
+			return "CUSTOM";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	/**
+	 * Behavior of the ingestion queue when it is full.
+	 */
+	enum DropPolicy {
+		DROP_NEWEST, DROP_OLDEST
+	};
+
+	static std::string dropPolicyToString(DropPolicy policy) {
+		switch (policy) {
+		case DROP_NEWEST:
+			return "NEWEST";
+		case DROP_OLDEST:
+			return "OLDEST";
+		default:
+			return "UNKNOWN";
+		}
+	}
+
+	/**
+	 * Wire encoding of dynamic transforms.
+	 */
+	enum Encoding {
+		ENCODING_DEFAULT, ENCODING_COMPACT
+	};
+
+	static std::string encodingToString(Encoding encoding) {
+		switch (encoding) {
+		case ENCODING_DEFAULT:
+			return "DEFAULT";
+		case ENCODING_COMPACT:
+			return "COMPACT";
 		default:
 			return "UNKNOWN";
 		}
 	}
 
 	TransformerConfig() :
-			commType(AUTO), cacheTime(
-					boost::posix_time::time_duration(0, 0, 30)) {
+			commType(AUTO), coreName("TF2"), batchingEnabled(false), loopbackEnabled(false), fanoutEnabled(false), bridgingEnabled(false), aggregationWindow(boost::posix_time::seconds(0)), syncWindow(
+					boost::posix_time::milliseconds(100)), syncBatchSize(256), resendHistory(1024), staticInitialSync(false), encoding(ENCODING_DEFAULT), translationResolution(
+					1e-4), rotationResolution(1e-5), keyframeInterval(100), shmName("rct_transforms"), shmCapacity(4096), shmStaticCapacity(1024), replaySpeed(
+					1.0), replayStart(boost::posix_time::seconds(0)), replayRestamp(false), cacheTime(
+					boost::posix_time::time_duration(0, 0, 30)), historyTime(boost::posix_time::seconds(0)), lookupCacheSize(0), interestLearning(false), ingestionEnabled(false), ingestionDepth(
+					4096), ingestionBatchSize(64), ingestionDropPolicy(DROP_OLDEST), ingestionWorkers(1), ingestionStaticBatchSize(
+					1024) {
 	}
 	virtual ~TransformerConfig() {
 	}
@@ -50,6 +168,104 @@ public:
 		this->cacheTime = cacheTime;
 	}
 
+	/**
+	 * Time the TF2 core keeps samples in a compressed history in addition
+	 * to the uncompressed samples of the cache time. Lookups older than the
+	 * cache time are answered from the history. Samples are quantized with
+	 * the translation and rotation resolution. Not longer than the cache
+	 * time disables the history.
+	 */
+	const boost::posix_time::time_duration& getHistoryTime() const {
+		return historyTime;
+	}
+
+	void setHistoryTime(const boost::posix_time::time_duration& historyTime) {
+		this->historyTime = historyTime;
+	}
+
+	/**
+	 * Maximum number of lookup results a receiver memoizes. 0 disables the
+	 * lookup cache.
+	 */
+	size_t getLookupCacheSize() const {
+		return lookupCacheSize;
+	}
+
+	void setLookupCacheSize(size_t lookupCacheSize) {
+		this->lookupCacheSize = lookupCacheSize;
+	}
+
+	/** \brief The built-in core named by getCoreName(), CORE_CUSTOM for others */
+	CoreType getCoreType() const {
+		if (coreName == "TF2") {
+			return CORE_TF2;
+		} else if (coreName == "SHM") {
+			return CORE_SHM;
+		} else if (coreName == "OFFLINE") {
+			return CORE_OFFLINE;
+		}
+		return CORE_CUSTOM;
+	}
+
+	/**
+	 * Name of the core backend the factory creates, the value of the
+	 * `core.type' option. Besides the built-in types any backend registered
+	 * with TransformerCoreRegistry can be named.
+	 */
+	const std::string& getCoreName() const {
+		return coreName;
+	}
+
+	void setCoreName(const std::string& coreName) {
+		this->coreName = boost::algorithm::to_upper_copy(coreName);
+	}
+
+	/**
+	 * Options of the form `core.<backend>.<key>', by key, for the backend to
+	 * interpret. Options of backends not registered are kept as well.
+	 *
+	 * The SHM core reads `name' of its shared memory segment, `mode' READER
+	 * or WRITER (exactly one process per segment writes, all others only
+	 * read and do not receive transforms), and the `frames' and `samples'
+	 * per frame of a new segment. The OFFLINE core reads the log `file' and
+	 * the `blocksize' of the index it builds.
+	 */
+	std::map<std::string, std::string> getCoreOptions(const std::string& backend) const {
+		std::map<std::string, std::map<std::string, std::string> >::const_iterator it =
+				coreOptions.find(boost::algorithm::to_lower_copy(backend));
+		if (it == coreOptions.end()) {
+			return std::map<std::string, std::string>();
+		}
+		return it->second;
+	}
+
+	/**
+	 * A single option of getCoreOptions(), converted to the type of the
+	 * default value, which is returned if the option is not set.
+	 */
+	template<typename T>
+	T getCoreOption(const std::string& backend, const std::string& key,
+			const T& defaultValue) const {
+		std::map<std::string, std::string> options = getCoreOptions(backend);
+		std::map<std::string, std::string>::const_iterator it = options.find(key);
+		if (it == options.end()) {
+			return defaultValue;
+		}
+		try {
+			return boost::lexical_cast<T>(it->second);
+		} catch (boost::bad_lexical_cast &e) {
+			throw std::invalid_argument(
+					boost::str(
+							boost::format("Value `%1%' of core option `%2%.%3%' is invalid.")
+									% it->second % backend % key));
+		}
+	}
+
+	void setCoreOption(const std::string& backend, const std::string& key,
+			const std::string& value) {
+		coreOptions[boost::algorithm::to_lower_copy(backend)][key] = value;
+	}
+
 	CommunicatorType getCommType() const {
 		return commType;
 	}
@@ -58,6 +274,432 @@ public:
 		this->commType = commType;
 	}
 
+	/**
+	 * Whether communicators send a vector of transforms as a single message
+	 * where the middleware supports it. Receivers always accept both forms.
+	 */
+	bool isBatchingEnabled() const {
+		return batchingEnabled;
+	}
+
+	void setBatchingEnabled(bool batchingEnabled) {
+		this->batchingEnabled = batchingEnabled;
+	}
+
+	/**
+	 * Whether transforms are additionally exchanged with the communicators
+	 * of the same process directly, without serialization. Network
+	 * communicators then ignore messages from their own process.
+	 */
+	bool isLoopbackEnabled() const {
+		return loopbackEnabled;
+	}
+
+	void setLoopbackEnabled(bool loopbackEnabled) {
+		this->loopbackEnabled = loopbackEnabled;
+	}
+
+	/**
+	 * Whether AUTO uses every available communicator instead of only the
+	 * first one. Transforms arriving through several of them are delivered
+	 * once.
+	 */
+	bool isFanoutEnabled() const {
+		return fanoutEnabled;
+	}
+
+	void setFanoutEnabled(bool fanoutEnabled) {
+		this->fanoutEnabled = fanoutEnabled;
+	}
+
+	/**
+	 * Whether receivers forward what they receive through one communicator
+	 * with all others, replacing separate bridge processes between e.g.
+	 * RSB and ROS. Implies fanout.
+	 */
+	bool isBridgingEnabled() const {
+		return bridgingEnabled;
+	}
+
+	void setBridgingEnabled(bool bridgingEnabled) {
+		this->bridgingEnabled = bridgingEnabled;
+	}
+
+	/**
+	 * Dynamic transforms sent within this window after the first one are
+	 * collected and sent as a single message, where the communicator
+	 * supports it (ROS). 0 sends every transform immediately.
+	 * TransformPublisher::flush() sends collected transforms early.
+	 */
+	const boost::posix_time::time_duration& getAggregationWindow() const {
+		return aggregationWindow;
+	}
+
+	void setAggregationWindow(const boost::posix_time::time_duration& aggregationWindow) {
+		this->aggregationWindow = aggregationWindow;
+	}
+
+	/**
+	 * Sync requests arriving within this window after the first one are
+	 * answered with a single republish of the send cache.
+	 */
+	const boost::posix_time::time_duration& getSyncWindow() const {
+		return syncWindow;
+	}
+
+	void setSyncWindow(const boost::posix_time::time_duration& syncWindow) {
+		this->syncWindow = syncWindow;
+	}
+
+	/**
+	 * Maximum number of transforms per message when republishing the send
+	 * cache with batching enabled.
+	 */
+	size_t getSyncBatchSize() const {
+		return syncBatchSize;
+	}
+
+	void setSyncBatchSize(size_t syncBatchSize) {
+		this->syncBatchSize = syncBatchSize;
+	}
+
+	/**
+	 * Number of sent messages a communicator keeps to answer resend requests
+	 * for sequence ranges a receiver missed. Older ranges are answered with a
+	 * full republish. 0 disables the history.
+	 */
+	size_t getResendHistory() const {
+		return resendHistory;
+	}
+
+	void setResendHistory(size_t resendHistory) {
+		this->resendHistory = resendHistory;
+	}
+
+	/**
+	 * Request only the static transforms of the peers on startup. Dynamic
+	 * transforms are republished continuously by their sources and arrive
+	 * with their next update instead.
+	 */
+	bool isStaticInitialSync() const {
+		return staticInitialSync;
+	}
+
+	void setStaticInitialSync(bool staticInitialSync) {
+		this->staticInitialSync = staticInitialSync;
+	}
+
+	/**
+	 * Encoding used by communicators for dynamic transforms. The compact
+	 * encoding quantizes values and sends differences to the previous sample
+	 * of the same edge. Receivers always accept all encodings.
+	 */
+	Encoding getEncoding() const {
+		return encoding;
+	}
+
+	void setEncoding(Encoding encoding) {
+		this->encoding = encoding;
+	}
+
+	/**
+	 * Resolution of translations in the compact encoding in meters.
+	 */
+	double getTranslationResolution() const {
+		return translationResolution;
+	}
+
+	void setTranslationResolution(double translationResolution) {
+		this->translationResolution = translationResolution;
+	}
+
+	/**
+	 * Resolution of rotation quaternion components in the compact encoding.
+	 */
+	double getRotationResolution() const {
+		return rotationResolution;
+	}
+
+	void setRotationResolution(double rotationResolution) {
+		this->rotationResolution = rotationResolution;
+	}
+
+	/**
+	 * Every n-th sample of an edge is sent with absolute values in the
+	 * compact encoding.
+	 */
+	unsigned int getKeyframeInterval() const {
+		return keyframeInterval;
+	}
+
+	void setKeyframeInterval(unsigned int keyframeInterval) {
+		this->keyframeInterval = keyframeInterval;
+	}
+
+	/**
+	 * The publish policy for all edges without a specific one.
+	 */
+	const PublishPolicy& getPublishPolicy() const {
+		return publishPolicy;
+	}
+
+	void setPublishPolicy(const PublishPolicy& publishPolicy) {
+		this->publishPolicy = publishPolicy;
+	}
+
+	/**
+	 * The publish policy for edges ending in the given child frame. Options
+	 * not given for the frame are taken from the general policy.
+	 */
+	PublishPolicy getPublishPolicy(const std::string& child) const {
+		PublishPolicy policy = publishPolicy;
+		std::map<std::string, std::map<std::string, std::string> >::const_iterator it =
+				publishPolicyOptions.find(child);
+		if (it != publishPolicyOptions.end()) {
+			std::map<std::string, std::string>::const_iterator option;
+			for (option = it->second.begin(); option != it->second.end(); ++option) {
+				applyPublishOption(policy, option->first, option->second);
+			}
+		}
+		return policy;
+	}
+
+	/**
+	 * Sets a publish policy option for edges ending in the given child frame.
+	 * Keys are the ones of the publisher options, e.g. "maxrate".
+	 */
+	void setPublishPolicyOption(const std::string& child, const std::string& key,
+			const std::string& value) {
+		// validate now, apply on lookup
+		PublishPolicy policy;
+		applyPublishOption(policy, key, value);
+		publishPolicyOptions[child][key] = value;
+	}
+
+	/**
+	 * Whether the publish policies limit any edge.
+	 */
+	bool hasPublishPolicies() const {
+		return publishPolicy.isActive() || !publishPolicyOptions.empty();
+	}
+
+	/**
+	 * Frames a receiver needs. Only the transforms of their chains are
+	 * inserted into the core. Empty if no frames are configured.
+	 */
+	const std::vector<std::string>& getInterestFrames() const {
+		return interestFrames;
+	}
+
+	void setInterestFrames(const std::vector<std::string>& interestFrames) {
+		this->interestFrames = interestFrames;
+	}
+
+	/**
+	 * Root frames of subtrees a receiver needs completely.
+	 */
+	const std::vector<std::string>& getInterestSubtrees() const {
+		return interestSubtrees;
+	}
+
+	void setInterestSubtrees(const std::vector<std::string>& interestSubtrees) {
+		this->interestSubtrees = interestSubtrees;
+	}
+
+	/**
+	 * Whether a receiver adds the frames of its lookups to the frames it
+	 * needs. A lookup of a frame not needed before fails until the
+	 * transforms of its chain arrive again.
+	 */
+	bool isInterestLearning() const {
+		return interestLearning;
+	}
+
+	void setInterestLearning(bool interestLearning) {
+		this->interestLearning = interestLearning;
+	}
+
+	/**
+	 * Whether a receiver filters the incoming transforms at all.
+	 */
+	bool hasInterestFilter() const {
+		return interestLearning || !interestFrames.empty() || !interestSubtrees.empty();
+	}
+
+	/**
+	 * Name of the shared memory segment used by the SHM communicator. All
+	 * processes using the same name exchange transforms.
+	 */
+	const std::string& getShmName() const {
+		return shmName;
+	}
+
+	void setShmName(const std::string& shmName) {
+		this->shmName = shmName;
+	}
+
+	/**
+	 * Number of transforms the shared memory ring holds. Only applied by the
+	 * process creating the segment.
+	 */
+	boost::uint32_t getShmCapacity() const {
+		return shmCapacity;
+	}
+
+	void setShmCapacity(boost::uint32_t shmCapacity) {
+		this->shmCapacity = shmCapacity;
+	}
+
+	/**
+	 * Maximum number of static transforms kept in the shared memory segment
+	 * for late joining processes.
+	 */
+	boost::uint32_t getShmStaticCapacity() const {
+		return shmStaticCapacity;
+	}
+
+	void setShmStaticCapacity(boost::uint32_t shmStaticCapacity) {
+		this->shmStaticCapacity = shmStaticCapacity;
+	}
+
+	/**
+	 * Log file played back by the REPLAY communicator.
+	 */
+	const std::string& getReplayFile() const {
+		return replayFile;
+	}
+
+	void setReplayFile(const std::string& replayFile) {
+		this->replayFile = replayFile;
+	}
+
+	/**
+	 * Playback speed of the REPLAY communicator relative to the recording.
+	 * 0 replays as fast as possible.
+	 */
+	double getReplaySpeed() const {
+		return replaySpeed;
+	}
+
+	void setReplaySpeed(double replaySpeed) {
+		this->replaySpeed = replaySpeed;
+	}
+
+	/**
+	 * Offset into the log at which the REPLAY communicator starts.
+	 */
+	const boost::posix_time::time_duration& getReplayStart() const {
+		return replayStart;
+	}
+
+	void setReplayStart(const boost::posix_time::time_duration& replayStart) {
+		this->replayStart = replayStart;
+	}
+
+	/**
+	 * Whether the REPLAY communicator stamps dynamic transforms with the
+	 * time of their delivery instead of the recorded time.
+	 */
+	bool isReplayRestamp() const {
+		return replayRestamp;
+	}
+
+	void setReplayRestamp(bool replayRestamp) {
+		this->replayRestamp = replayRestamp;
+	}
+
+	/**
+	 * Log file to which receivers write every transform they receive.
+	 * Empty disables recording.
+	 */
+	const std::string& getRecordFile() const {
+		return recordFile;
+	}
+
+	void setRecordFile(const std::string& recordFile) {
+		this->recordFile = recordFile;
+	}
+
+	/**
+	 * File in which receivers keep the static transforms they received, to
+	 * load them immediately after a restart. Empty disables the snapshot.
+	 */
+	const std::string& getSnapshotFile() const {
+		return snapshotFile;
+	}
+
+	void setSnapshotFile(const std::string& snapshotFile) {
+		this->snapshotFile = snapshotFile;
+	}
+
+	/**
+	 * Whether received transforms are handed to an asynchronous ingestion
+	 * queue instead of being applied on the middleware callback thread.
+	 */
+	bool isIngestionEnabled() const {
+		return ingestionEnabled;
+	}
+
+	void setIngestionEnabled(bool ingestionEnabled) {
+		this->ingestionEnabled = ingestionEnabled;
+	}
+
+	/**
+	 * Maximum number of dynamic transforms waiting in the ingestion queue.
+	 * Static transforms are never dropped, only the latest one per child
+	 * frame waits. Must be at least 1.
+	 */
+	size_t getIngestionDepth() const {
+		return ingestionDepth;
+	}
+
+	void setIngestionDepth(size_t ingestionDepth) {
+		this->ingestionDepth = ingestionDepth;
+	}
+
+	/**
+	 * Maximum number of transforms a worker applies to the core at once.
+	 */
+	size_t getIngestionBatchSize() const {
+		return ingestionBatchSize;
+	}
+
+	void setIngestionBatchSize(size_t ingestionBatchSize) {
+		this->ingestionBatchSize = ingestionBatchSize;
+	}
+
+	DropPolicy getIngestionDropPolicy() const {
+		return ingestionDropPolicy;
+	}
+
+	void setIngestionDropPolicy(DropPolicy ingestionDropPolicy) {
+		this->ingestionDropPolicy = ingestionDropPolicy;
+	}
+
+	/**
+	 * Number of worker threads draining the ingestion queue.
+	 */
+	unsigned int getIngestionWorkers() const {
+		return ingestionWorkers;
+	}
+
+	void setIngestionWorkers(unsigned int ingestionWorkers) {
+		this->ingestionWorkers = ingestionWorkers;
+	}
+
+	/**
+	 * Maximum number of static transforms a worker applies to the core at
+	 * once while no dynamic ones wait. Under dynamic load a worker applies
+	 * at most the dynamic batch size of static transforms per dynamic batch.
+	 */
+	size_t getIngestionStaticBatchSize() const {
+		return ingestionStaticBatchSize;
+	}
+
+	void setIngestionStaticBatchSize(size_t ingestionStaticBatchSize) {
+		this->ingestionStaticBatchSize = ingestionStaticBatchSize;
+	}
+
 	/**
 	 * Returns additional options besides the transformer-specific ones.
 	 *
@@ -97,33 +739,212 @@ public:
 		case ROS:
 			stream << "comm = ROS";
 			break;
+		case SHM:
+			stream << "comm = SHM";
+			break;
+		case LOOPBACK:
+			stream << "comm = LOOPBACK";
+			break;
+		case REPLAY:
+			stream << "comm = REPLAY";
+			break;
 		default:
 			stream << "comm = UNKNOWN";
 			break;
 		}
+		if (batchingEnabled) {
+			stream << ", batching = true";
+		}
+		if (loopbackEnabled) {
+			stream << ", loopback = true";
+		}
+		if (bridgingEnabled) {
+			stream << ", bridge = true";
+		} else if (fanoutEnabled) {
+			stream << ", fanout = true";
+		}
+		if (aggregationWindow > boost::posix_time::seconds(0)) {
+			stream << ", aggregationWindow = " << aggregationWindow;
+		}
+		stream << ", syncWindow = " << syncWindow;
+		stream << ", resendHistory = " << resendHistory;
+		if (staticInitialSync) {
+			stream << ", staticInitialSync = true";
+		}
+		if (encoding == ENCODING_COMPACT) {
+			stream << ", encoding = {type = COMPACT";
+			stream << ", translationResolution = " << translationResolution;
+			stream << ", rotationResolution = " << rotationResolution;
+			stream << ", keyframeInterval = " << keyframeInterval << "}";
+		}
+		if (commType == SHM) {
+			stream << ", shm = {name = " << shmName;
+			stream << ", capacity = " << shmCapacity;
+			stream << ", staticCapacity = " << shmStaticCapacity << "}";
+		}
+		if (commType == REPLAY) {
+			stream << ", replay = {file = " << replayFile;
+			stream << ", speed = " << replaySpeed;
+			stream << ", start = " << replayStart;
+			stream << ", restamp = " << replayRestamp << "}";
+		}
+		if (!recordFile.empty()) {
+			stream << ", recordFile = " << recordFile;
+		}
+		stream << ", core = " << coreName;
+		std::map<std::string, std::string> backendOptions = getCoreOptions(coreName);
+		if (!backendOptions.empty()) {
+			stream << ", coreOptions = {";
+			std::map<std::string, std::string>::const_iterator option;
+			for (option = backendOptions.begin(); option != backendOptions.end(); ++option) {
+				stream << (option == backendOptions.begin() ? "" : ", ") << option->first << " = "
+						<< option->second;
+			}
+			stream << "}";
+		}
 		stream << ", cacheTime = " << cacheTime;
+		if (historyTime > cacheTime) {
+			stream << ", historyTime = " << historyTime;
+		}
+		if (lookupCacheSize > 0) {
+			stream << ", lookupCacheSize = " << lookupCacheSize;
+		}
+		if (!snapshotFile.empty()) {
+			stream << ", snapshotFile = " << snapshotFile;
+		}
+		if (hasInterestFilter()) {
+			stream << ", interest = {#frames = " << interestFrames.size();
+			stream << ", #subtrees = " << interestSubtrees.size();
+			stream << ", learn = " << interestLearning << "}";
+		}
+		if (hasPublishPolicies()) {
+			stream << ", publishPolicy = {";
+			publishPolicy.printContents(stream);
+			stream << "}, #publishPolicies = " << publishPolicyOptions.size();
+		}
+		if (ingestionEnabled) {
+			stream << ", ingestion = {depth = " << ingestionDepth;
+			stream << ", batchSize = " << ingestionBatchSize;
+			stream << ", dropPolicy = " << dropPolicyToString(ingestionDropPolicy);
+			stream << ", workers = " << ingestionWorkers;
+			stream << ", staticBatchSize = " << ingestionStaticBatchSize << "}";
+		}
 
 	}
 
 private:
 	CommunicatorType commType;
+	std::string coreName;
+	std::map<std::string, std::map<std::string, std::string> > coreOptions;
+	bool batchingEnabled;
+	bool loopbackEnabled;
+	bool fanoutEnabled;
+	bool bridgingEnabled;
+	boost::posix_time::time_duration aggregationWindow;
+	boost::posix_time::time_duration syncWindow;
+	size_t syncBatchSize;
+	size_t resendHistory;
+	bool staticInitialSync;
+	Encoding encoding;
+	double translationResolution;
+	double rotationResolution;
+	unsigned int keyframeInterval;
+	std::string shmName;
+	boost::uint32_t shmCapacity;
+	boost::uint32_t shmStaticCapacity;
+	std::string replayFile;
+	double replaySpeed;
+	boost::posix_time::time_duration replayStart;
+	bool replayRestamp;
+	std::string recordFile;
 	boost::posix_time::time_duration cacheTime;
+	boost::posix_time::time_duration historyTime;
+	size_t lookupCacheSize;
+	std::vector<std::string> interestFrames;
+	std::vector<std::string> interestSubtrees;
+	bool interestLearning;
+	std::string snapshotFile;
+	bool ingestionEnabled;
+	size_t ingestionDepth;
+	size_t ingestionBatchSize;
+	DropPolicy ingestionDropPolicy;
+	unsigned int ingestionWorkers;
+	size_t ingestionStaticBatchSize;
+	PublishPolicy publishPolicy;
+	std::map<std::string, std::map<std::string, std::string> > publishPolicyOptions;
 	rsc::runtime::Properties options;
+
+	static void applyPublishOption(PublishPolicy& policy, const std::string& key,
+			const std::string& value) {
+		if (key == "maxrate") {
+			policy.maxRate = boost::lexical_cast<double>(value);
+		} else if (key == "translationthreshold") {
+			policy.translationThreshold = boost::lexical_cast<double>(value);
+		} else if (key == "rotationthreshold") {
+			policy.rotationThreshold = boost::lexical_cast<double>(value);
+		} else if (key == "keepalive") {
+			policy.keepalive = boost::posix_time::duration_from_string(value);
+		} else {
+			throw std::invalid_argument(
+					boost::str(boost::format("`%1%' is not a publisher option.") % key));
+		}
+	}
+
+	static std::vector<std::string> parseList(const std::string& value) {
+		std::vector<std::string> list;
+		boost::algorithm::split(list, value, boost::algorithm::is_any_of(","));
+		std::vector<std::string> result;
+		std::vector<std::string>::iterator it;
+		for (it = list.begin(); it != list.end(); ++it) {
+			boost::algorithm::trim(*it);
+			if (!it->empty()) {
+				result.push_back(*it);
+			}
+		}
+		return result;
+	}
+
+	static bool parseBool(const std::string& value) {
+		std::string v = boost::algorithm::to_lower_copy(value);
+		if (v == "true" || v == "1" || v == "yes" || v == "on") {
+			return true;
+		} else if (v == "false" || v == "0" || v == "no" || v == "off") {
+			return false;
+		}
+		throw std::invalid_argument(
+				boost::str(boost::format("Value `%1%' is not a boolean.") % value));
+	}
+
 	void handleOption(const std::vector<std::string>& key,
 			const std::string& value) {
 
 		if (key[0] == "core") {
+			if (key.size() == 3) {
+				// passed through to the backend
+				setCoreOption(key[1], key[2], value);
+				return;
+			}
 			if (key.size() != 2) {
 				throw std::invalid_argument(
 						boost::str(
 								boost::format(
-										"Option key `%1%' has invalid number of components; options related to core have to have two components.")
+										"Option key `%1%' has invalid number of components; options related to core have to have two or three components.")
 										% key));
 			}
 
-			if (key[1] == "cachetime") {
+			if (key[1] == "type") {
+				// backends register at link time, the factory rejects unknown names
+				if (value.empty()) {
+					throw std::invalid_argument("Core type must not be empty.");
+				}
+				setCoreName(value);
+			} else if (key[1] == "cachetime") {
 				this->cacheTime = boost::posix_time::duration_from_string(
 						value);
+			} else if (key[1] == "historytime") {
+				this->historyTime = boost::posix_time::duration_from_string(value);
+			} else if (key[1] == "lookupcachesize") {
+				this->lookupCacheSize = boost::lexical_cast<size_t>(value);
 			}
 		} else if (key[0] == "communicator") {
 			if (key.size() != 2) {
@@ -140,6 +961,12 @@ private:
 					this->commType = RSB;
 				} else if (value == "ROS") {
 					this->commType = ROS;
+				} else if (value == "SHM") {
+					this->commType = SHM;
+				} else if (value == "LOOPBACK") {
+					this->commType = LOOPBACK;
+				} else if (value == "REPLAY") {
+					this->commType = REPLAY;
 				} else {
 					throw std::invalid_argument(
 							boost::str(
@@ -147,8 +974,159 @@ private:
 											"Value `%1%' does not name a communicator type.")
 											% value));
 				}
+			} else if (key[1] == "batching") {
+				this->batchingEnabled = parseBool(value);
+			} else if (key[1] == "loopback") {
+				this->loopbackEnabled = parseBool(value);
+			} else if (key[1] == "fanout") {
+				this->fanoutEnabled = parseBool(value);
+			} else if (key[1] == "bridge") {
+				this->bridgingEnabled = parseBool(value);
+			} else if (key[1] == "aggregationwindow") {
+				this->aggregationWindow = boost::posix_time::duration_from_string(value);
+			} else if (key[1] == "syncwindow") {
+				this->syncWindow = boost::posix_time::duration_from_string(value);
+			} else if (key[1] == "syncbatchsize") {
+				this->syncBatchSize = boost::lexical_cast<size_t>(value);
+			} else if (key[1] == "resendhistory") {
+				this->resendHistory = boost::lexical_cast<size_t>(value);
+			} else if (key[1] == "staticinitialsync") {
+				this->staticInitialSync = parseBool(value);
+			} else if (key[1] == "encoding") {
+				if (value == "DEFAULT") {
+					this->encoding = ENCODING_DEFAULT;
+				} else if (value == "COMPACT") {
+					this->encoding = ENCODING_COMPACT;
+				} else {
+					throw std::invalid_argument(
+							boost::str(
+									boost::format(
+											"Value `%1%' does not name an encoding.")
+											% value));
+				}
+			} else if (key[1] == "translationresolution") {
+				this->translationResolution = boost::lexical_cast<double>(value);
+			} else if (key[1] == "rotationresolution") {
+				this->rotationResolution = boost::lexical_cast<double>(value);
+			} else if (key[1] == "keyframeinterval") {
+				this->keyframeInterval = boost::lexical_cast<unsigned int>(value);
 			}
 
+		} else if (key[0] == "shm") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to shared memory have to have two components.")
+										% key));
+			}
+			if (key[1] == "name") {
+				this->shmName = value;
+			} else if (key[1] == "capacity") {
+				this->shmCapacity = boost::lexical_cast<boost::uint32_t>(value);
+			} else if (key[1] == "staticcapacity") {
+				this->shmStaticCapacity = boost::lexical_cast<boost::uint32_t>(value);
+			}
+		} else if (key[0] == "replay") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to replay have to have two components.")
+										% key));
+			}
+			if (key[1] == "file") {
+				this->replayFile = value;
+			} else if (key[1] == "speed") {
+				this->replaySpeed = boost::lexical_cast<double>(value);
+			} else if (key[1] == "start") {
+				this->replayStart = boost::posix_time::duration_from_string(value);
+			} else if (key[1] == "restamp") {
+				this->replayRestamp = parseBool(value);
+			}
+		} else if (key[0] == "record") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to recording have to have two components.")
+										% key));
+			}
+			if (key[1] == "file") {
+				this->recordFile = value;
+			}
+		} else if (key[0] == "snapshot") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to the snapshot have to have two components.")
+										% key));
+			}
+			if (key[1] == "file") {
+				this->snapshotFile = value;
+			}
+		} else if (key[0] == "receiver") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to the receiver have to have two components.")
+										% key));
+			}
+			if (key[1] == "frames") {
+				this->interestFrames = parseList(value);
+			} else if (key[1] == "subtrees") {
+				this->interestSubtrees = parseList(value);
+			} else if (key[1] == "learn") {
+				this->interestLearning = parseBool(value);
+			}
+		} else if (key[0] == "publisher") {
+			if (key.size() == 2) {
+				applyPublishOption(this->publishPolicy, key[1], value);
+			} else if (key.size() == 3) {
+				setPublishPolicyOption(key[1], key[2], value);
+			} else {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to the publisher have to have two or three components.")
+										% key));
+			}
+		} else if (key[0] == "ingestion") {
+			if (key.size() != 2) {
+				throw std::invalid_argument(
+						boost::str(
+								boost::format(
+										"Option key `%1%' has invalid number of components; options related to ingestion have to have two components.")
+										% key));
+			}
+			if (key[1] == "enabled") {
+				this->ingestionEnabled = parseBool(value);
+			} else if (key[1] == "depth") {
+				this->ingestionDepth = boost::lexical_cast<size_t>(value);
+				if (this->ingestionDepth < 1) {
+					throw std::invalid_argument("Ingestion depth must be at least 1.");
+				}
+			} else if (key[1] == "batchsize") {
+				this->ingestionBatchSize = boost::lexical_cast<size_t>(value);
+			} else if (key[1] == "staticbatchsize") {
+				this->ingestionStaticBatchSize = boost::lexical_cast<size_t>(value);
+			} else if (key[1] == "workers") {
+				this->ingestionWorkers = boost::lexical_cast<unsigned int>(value);
+			} else if (key[1] == "droppolicy") {
+				if (value == "NEWEST") {
+					this->ingestionDropPolicy = DROP_NEWEST;
+				} else if (value == "OLDEST") {
+					this->ingestionDropPolicy = DROP_OLDEST;
+				} else {
+					throw std::invalid_argument(
+							boost::str(
+									boost::format(
+											"Value `%1%' does not name a drop policy.")
+											% value));
+				}
+			}
 		} else {
 			if (key.size() == 1) {
 				this->options[key[0]] = value;
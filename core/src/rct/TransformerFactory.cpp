@@ -7,21 +7,33 @@
 
 #include "TransformerFactory.h"
 #include "rct/rctConfig.h"
-#ifdef RCT_HAVE_TF2
-#include "impl/TransformerTF2.h"
-#endif
+#include "impl/TransformIngestionQueue.h"
+#include "impl/StaticTransformSnapshot.h"
+#include "impl/TransformCommLoopback.h"
+#include "impl/TransformCommCombined.h"
+#include "impl/TransformBridge.h"
+#include "impl/TransformCommReplay.h"
+#include "impl/TransformRecorder.h"
+#include "impl/TransformerCoreRegistry.h"
 #ifdef RCT_HAVE_RSB
 #include <rct/impl/TransformCommRsb.h>
 #endif
 #ifdef RCT_HAVE_ROS
 #include <rct/impl/TransformCommRos.h>
 #endif
+#ifdef RCT_HAVE_SHM
+#include <rct/impl/TransformCommShm.h>
+#include <rct/impl/TransformerShm.h>
+#endif
 
 using namespace std;
 
 namespace rct {
 
 TransformerFactory::TransformerFactory() {
+#ifdef RCT_HAVE_SHM
+	registerShmCore();
+#endif
 }
 
 TransformerFactory::~TransformerFactory() {
@@ -49,44 +61,122 @@ TransformReceiver::Ptr TransformerFactory::createTransformReceiver(const Transfo
 TransformReceiver::Ptr TransformerFactory::createTransformReceiver(const vector<TransformListener::Ptr>& listeners, const TransformerConfig& config) const {
 	vector<TransformListener::Ptr> allListeners;
 	allListeners.insert(allListeners.end(), listeners.begin(), listeners.end());
-	TransformerCore::Ptr core;
+	// an attached core is filled by another process or from a file
+	bool attached = false;
+	TransformerCore::Ptr core = TransformerCoreRegistry::create(config.getCoreName(), config, attached);
+	if (!core) {
+		throw TransformerFactoryException(
+				"Core " + config.getCoreName() + " not available! Registered cores: "
+						+ boost::algorithm::join(TransformerCoreRegistry::getNames(), ", "));
+	}
 
-#ifdef RCT_HAVE_TF2
-	core = TransformerTF2::Ptr(new TransformerTF2(config.getCacheTime()));
-#else
-	throw TransformerFactoryException("No known logic implementation available!");
-#endif
+	if (!config.getRecordFile().empty()) {
+		// records what arrives, independent of what the core keeps
+		TransformRecorder::Ptr recorder(new TransformRecorder(config.getRecordFile()));
+		allListeners.push_back(recorder);
+	}
+
+	if (attached && allListeners.empty()) {
+		// lookups read the shared buffer or the file, there is nothing to receive
+		TransformReceiver::Ptr transformer(
+				new TransformReceiver(core, TransformCommunicator::Ptr(), config));
+		return transformer;
+	}
+
+	vector<TransformListener::Ptr> coreListeners;
+	coreListeners.push_back(core);
+
+	// an attached core needs neither a cache nor a filter, nothing is inserted
+	TransformLookupCache::Ptr lookupCache;
+	if (config.getLookupCacheSize() > 0 && !attached) {
+		// must be notified after the core to invalidate precisely
+		lookupCache = TransformLookupCache::Ptr(new TransformLookupCache(core, config.getLookupCacheSize(),
+				config.getCacheTime()));
+		coreListeners.push_back(lookupCache);
+	}
+
+	TransformInterestFilter::Ptr interestFilter;
+	if (config.hasInterestFilter() && !attached) {
+		// user listeners still get every transform
+		interestFilter = TransformInterestFilter::Ptr(
+				new TransformInterestFilter(coreListeners, config.getInterestFrames(),
+						config.getInterestSubtrees()));
+		coreListeners.clear();
+		coreListeners.push_back(interestFilter);
+	}
+	if (!attached) {
+		allListeners.insert(allListeners.end(), coreListeners.begin(), coreListeners.end());
+	}
+
+	if (!config.getSnapshotFile().empty() && !attached) {
+		// static chains are usable before the peers answered the sync request
+		StaticTransformSnapshot::Ptr snapshot(new StaticTransformSnapshot(config.getSnapshotFile()));
+		snapshot->load(core);
+		allListeners.push_back(snapshot);
+	}
 
-	allListeners.push_back(core);
+	if (config.isIngestionEnabled()) {
+		// apply transforms on dedicated workers instead of the middleware threads
+		TransformIngestionQueue::Ptr queue(new TransformIngestionQueue(allListeners, config));
+		allListeners.clear();
+		allListeners.push_back(queue);
+	}
 
 	// order is priority
 	vector<TransformCommunicator::Ptr> comms;
 #ifdef RCT_HAVE_RSB
 	if (config.getCommType() == TransformerConfig::AUTO || config.getCommType() == TransformerConfig::RSB) {
-		TransformCommRsb::Ptr p(new TransformCommRsb("read-only", allListeners));
+		TransformCommRsb::Ptr p(new TransformCommRsb("read-only"));
 		comms.push_back(p);
 	}
 #endif
 #ifdef RCT_HAVE_ROS
 	if (config.getCommType() == TransformerConfig::AUTO || config.getCommType() == TransformerConfig::ROS) {
-		TransformCommRos::Ptr p(new TransformCommRos(config.getCacheTime(), allListeners));
-		comms.push_back();
+		TransformCommRos::Ptr p(new TransformCommRos("read-only", config.getCacheTime()));
+		comms.push_back(p);
 	}
 #endif
-
-#ifndef RCT_HAVE_RSB
-#ifndef RCT_HAVE_ROS
-	throw TransformerFactoryException("No known communicator implementation available!");
-#endif
+#ifdef RCT_HAVE_SHM
+	// same host only, therefore never chosen automatically
+	if (config.getCommType() == TransformerConfig::SHM) {
+		TransformCommShm::Ptr p(new TransformCommShm("read-only"));
+		comms.push_back(p);
+	}
 #endif
+	if (config.getCommType() == TransformerConfig::LOOPBACK) {
+		TransformCommLoopback::Ptr p(new TransformCommLoopback("read-only"));
+		comms.push_back(p);
+	}
+	if (config.getCommType() == TransformerConfig::REPLAY) {
+		TransformCommReplay::Ptr p(new TransformCommReplay("read-only"));
+		comms.push_back(p);
+	}
 
 	if (comms.empty()) {
 		throw TransformerFactoryException(string("Can not generate communicator " + TransformerConfig::typeToString(config.getCommType())));
 	}
 
-	//todo
-	comms[0]->init(config);
-	TransformReceiver::Ptr transformer(new TransformReceiver(core, comms[0], config));
+	TransformCommunicator::Ptr comm;
+	if ((config.isFanoutEnabled() || config.isBridgingEnabled()) && comms.size() > 1) {
+		// the bridge delivers transforms arriving through several transports once
+		TransformBridge::Ptr bridge(new TransformBridge(allListeners, config.isBridgingEnabled()));
+		for (size_t i = 0; i < comms.size(); ++i) {
+			bridge->attach(comms[i]);
+		}
+		comm = TransformCommCombined::Ptr(new TransformCommCombined(comms));
+	} else {
+		comm = comms[0];
+		comm->addTransformListener(allListeners);
+	}
+
+	if (config.isLoopbackEnabled() && config.getCommType() != TransformerConfig::LOOPBACK) {
+		// local publishers are received without serialization
+		TransformCommLoopback::Ptr loopback(new TransformCommLoopback("read-only", allListeners));
+		comm = TransformCommCombined::Ptr(new TransformCommCombined(comm, loopback));
+	}
+
+	comm->init(config);
+	TransformReceiver::Ptr transformer(new TransformReceiver(core, comm, config, lookupCache, interestFilter));
 	return transformer;
 }
 
@@ -102,24 +192,36 @@ TransformPublisher::Ptr TransformerFactory::createTransformPublisher(const std::
 #endif
 #ifdef RCT_HAVE_ROS
 	if (config.getCommType() == TransformerConfig::AUTO || config.getCommType() == TransformerConfig::ROS) {
-		TransformCommRos::Ptr p(new TransformCommRos(config.getCacheTime(), allListeners));
-		comms.push_back();
+		TransformCommRos::Ptr p(new TransformCommRos(name, config.getCacheTime()));
+		comms.push_back(p);
 	}
 #endif
-
-#ifndef RCT_HAVE_RSB
-#ifndef RCT_HAVE_ROS
-	throw TransformerFactoryException("No known communicator implementation available!");
-#endif
+#ifdef RCT_HAVE_SHM
+	if (config.getCommType() == TransformerConfig::SHM) {
+		TransformCommShm::Ptr p(new TransformCommShm(name));
+		comms.push_back(p);
+	}
 #endif
+	if (config.getCommType() == TransformerConfig::LOOPBACK) {
+		TransformCommLoopback::Ptr p(new TransformCommLoopback(name));
+		comms.push_back(p);
+	}
 
 	if (comms.empty()) {
 		throw TransformerFactoryException(string("Can not generate communicator " + TransformerConfig::typeToString(config.getCommType())));
 	}
 
-	//todo
-	comms[0]->init(config);
-	TransformPublisher::Ptr transformer(new TransformPublisher(comms[0], config));
+	TransformCommunicator::Ptr comm = comms[0];
+	if ((config.isFanoutEnabled() || config.isBridgingEnabled()) && comms.size() > 1) {
+		comm = TransformCommCombined::Ptr(new TransformCommCombined(comms));
+	}
+	if (config.isLoopbackEnabled() && config.getCommType() != TransformerConfig::LOOPBACK) {
+		TransformCommLoopback::Ptr loopback(new TransformCommLoopback(name));
+		comm = TransformCommCombined::Ptr(new TransformCommCombined(comm, loopback));
+	}
+
+	comm->init(config);
+	TransformPublisher::Ptr transformer(new TransformPublisher(comm, config));
 	return transformer;
 }
 }
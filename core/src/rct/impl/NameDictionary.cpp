@@ -0,0 +1,77 @@
+/*
+ * NameDictionary.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "NameDictionary.h"
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+// ids are indices, so announcements of misbehaving senders must not make us
+// allocate arbitrarily large tables
+static const boost::uint32_t maxId = 1 << 20;
+
+NameDictionary::NameDictionary() {
+}
+
+NameDictionary::~NameDictionary() {
+}
+
+boost::uint32_t NameDictionary::encode(const string& name) {
+	map<string, boost::uint32_t>::const_iterator it = ids.find(name);
+	if (it != ids.end()) {
+		return it->second;
+	}
+	boost::uint32_t id = names.size();
+	ids[name] = id;
+	names.push_back(name);
+	defined.push_back(true);
+	return id;
+}
+
+void NameDictionary::define(boost::uint32_t id, const string& name) {
+	if (id >= maxId) {
+		throw std::out_of_range("Dictionary id out of range");
+	}
+	if (id >= names.size()) {
+		names.resize(id + 1);
+		defined.resize(id + 1, false);
+	} else if (defined[id]) {
+		ids.erase(names[id]);
+	}
+	names[id] = name;
+	defined[id] = true;
+	ids[name] = id;
+}
+
+bool NameDictionary::decode(boost::uint32_t id, string& name) const {
+	if (id >= names.size() || !defined[id]) {
+		return false;
+	}
+	name = names[id];
+	return true;
+}
+
+const string& NameDictionary::getName(boost::uint32_t id) const {
+	if (id >= names.size() || !defined[id]) {
+		throw std::out_of_range("Unknown dictionary id");
+	}
+	return names[id];
+}
+
+size_t NameDictionary::size() const {
+	return names.size();
+}
+
+void NameDictionary::clear() {
+	ids.clear();
+	names.clear();
+	defined.clear();
+}
+
+}  // namespace rct
@@ -0,0 +1,49 @@
+/*
+ * NameDictionary.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Maps frame and authority names to small consecutive ids.
+ *
+ * A sender assigns ids with encode() and announces every entry once, e.g.
+ * in the first message referencing it. Receivers keep one dictionary per
+ * sender and fill it with define().
+ */
+class NameDictionary {
+public:
+	NameDictionary();
+	virtual ~NameDictionary();
+
+	/** \brief The id of the name. Unknown names get the next free id. */
+	boost::uint32_t encode(const std::string& name);
+
+	void define(boost::uint32_t id, const std::string& name);
+
+	/** \return false if the id was not defined */
+	bool decode(boost::uint32_t id, std::string& name) const;
+
+	/** \brief Name of an id assigned by encode() or define() */
+	const std::string& getName(boost::uint32_t id) const;
+
+	size_t size() const;
+	void clear();
+
+private:
+	std::map<std::string, boost::uint32_t> ids;
+	std::vector<std::string> names;
+	std::vector<bool> defined;
+};
+
+}  // namespace rct
@@ -0,0 +1,342 @@
+/*
+ * StaticTransformSnapshot.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "StaticTransformSnapshot.h"
+#include "TransformQuantizer.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/filesystem.hpp>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr StaticTransformSnapshot::logger = rsc::logging::Logger::getLogger(
+		"rct.core.StaticTransformSnapshot");
+
+static const char magic[8] = { 'R', 'C', 'T', 'S', 'N', 'A', 'P', '\0' };
+static const boost::uint32_t formatVersion = 2;
+
+// the stamp of a static transform changes with every republication
+static bool sameStatic(const TransformRecord& a, const TransformRecord& b) {
+	return memcmp(a.parent, b.parent, TransformRecord::nameSize) == 0
+			&& memcmp(a.child, b.child, TransformRecord::nameSize) == 0
+			&& memcmp(a.translation, b.translation, sizeof(a.translation)) == 0
+			&& memcmp(a.rotation, b.rotation, sizeof(a.rotation)) == 0;
+}
+
+static boost::int64_t nowMicroseconds() {
+	return toMicroseconds(boost::posix_time::microsec_clock::universal_time());
+}
+
+StaticTransformSnapshot::StaticTransformSnapshot(const string& file,
+		const boost::posix_time::time_duration& maxAge) :
+		file(file), maxAge(maxAge), dirty(false), running(true) {
+	writer = boost::thread(&StaticTransformSnapshot::writeChanges, this);
+}
+
+StaticTransformSnapshot::~StaticTransformSnapshot() {
+	shutdown();
+}
+
+size_t StaticTransformSnapshot::load(const TransformerCore::Ptr& core) {
+	vector<Transform> transforms;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		read(transforms);
+	}
+	if (transforms.empty()) {
+		return 0;
+	}
+	RSCINFO(logger, "Loaded " << transforms.size() << " static transforms from " << file);
+	core->setTransforms(transforms, true);
+	return transforms.size();
+}
+
+void StaticTransformSnapshot::read(vector<Transform>& adopted) {
+	if (!boost::filesystem::exists(file)) {
+		RSCDEBUG(logger, "No snapshot at " << file);
+		return;
+	}
+
+	try {
+		boost::interprocess::file_mapping mapping(file.c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region region(mapping, boost::interprocess::read_only);
+		const char* data = static_cast<const char*>(region.get_address());
+		size_t size = region.get_size();
+
+		if (size < sizeof(FileHeader)) {
+			RSCWARN(logger, "Ignoring truncated snapshot " << file);
+			return;
+		}
+		const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+		if (memcmp(header->magic, magic, sizeof(magic)) != 0
+				|| header->formatVersion != formatVersion
+				|| header->recordSize != sizeof(TransformRecord)) {
+			RSCWARN(logger, "Ignoring snapshot " << file << " of unknown format");
+			return;
+		}
+		size_t expected = sizeof(FileHeader) + header->authorityCount * sizeof(AuthorityEntry)
+				+ header->recordCount * (sizeof(TransformRecord) + sizeof(boost::int64_t));
+		if (size != expected) {
+			RSCWARN(logger, "Ignoring snapshot " << file << " with invalid size");
+			return;
+		}
+
+		const AuthorityEntry* entries = reinterpret_cast<const AuthorityEntry*>(data
+				+ sizeof(FileHeader));
+		const TransformRecord* records = reinterpret_cast<const TransformRecord*>(data
+				+ sizeof(FileHeader) + header->authorityCount * sizeof(AuthorityEntry));
+		const char* received = reinterpret_cast<const char*>(records + header->recordCount);
+		const boost::int64_t horizon = nowMicroseconds() - maxAge.total_microseconds();
+
+		for (boost::uint32_t a = 0; a < header->authorityCount; ++a) {
+			const AuthorityEntry& entry = entries[a];
+			// the sum could wrap
+			if (entry.recordCount > header->recordCount
+					|| entry.firstRecord > header->recordCount - entry.recordCount) {
+				RSCWARN(logger, "Ignoring invalid authority entry in snapshot " << file);
+				continue;
+			}
+			string authority(entry.authority, strnlen(entry.authority, TransformRecord::nameSize));
+			map<string, AuthorityState>::iterator known = authorities.find(authority);
+			if (known != authorities.end() && known->second.version >= entry.version) {
+				// our data of this authority is at least as recent
+				continue;
+			}
+
+			AuthorityState& state = authorities[authority];
+			state.version = entry.version;
+			state.records.clear();
+			state.received.clear();
+			for (boost::uint32_t r = entry.firstRecord; r < entry.firstRecord + entry.recordCount;
+					++r) {
+				// may be unaligned after the records
+				boost::int64_t time;
+				memcpy(&time, received + r * sizeof(boost::int64_t), sizeof(time));
+				if (time < horizon) {
+					continue;
+				}
+				Transform transform;
+				records[r].toTransform(transform);
+				state.records[transform.getFrameChild()] = records[r];
+				state.received[transform.getFrameChild()] = time;
+				adopted.push_back(transform);
+			}
+			if (state.records.empty()) {
+				authorities.erase(authority);
+			}
+		}
+	} catch (boost::interprocess::interprocess_exception &e) {
+		RSCWARN(logger, "Cannot map snapshot " << file << ". Reason: " << e.what());
+	}
+}
+
+void StaticTransformSnapshot::newTransformAvailable(const Transform& transform, bool isStatic) {
+	if (!isStatic) {
+		return;
+	}
+	bool changed;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		changed = update(transform);
+	}
+	if (changed) {
+		condition.notify_one();
+	}
+}
+
+void StaticTransformSnapshot::newTransformsAvailable(const vector<Transform>& transforms,
+		bool isStatic) {
+	if (!isStatic) {
+		return;
+	}
+	bool changed = false;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			changed = update(*it) || changed;
+		}
+	}
+	if (changed) {
+		condition.notify_one();
+	}
+}
+
+bool StaticTransformSnapshot::update(const Transform& transform) {
+	TransformRecord record;
+	if (!record.fromTransform(transform)) {
+		RSCDEBUG(logger, "Not storing " << transform.getFrameChild() << ", name too long");
+		return false;
+	}
+
+	AuthorityState& state = authorities[transform.getAuthority()];
+	// written with the next change, a sync alone does not rewrite the file
+	state.received[transform.getFrameChild()] = nowMicroseconds();
+	map<string, TransformRecord>::iterator it = state.records.find(transform.getFrameChild());
+	if (it != state.records.end() && sameStatic(it->second, record)) {
+		// republished by a sync
+		return false;
+	}
+	state.records[transform.getFrameChild()] = record;
+	state.version++;
+	dirty = true;
+	return true;
+}
+
+void StaticTransformSnapshot::flush() {
+	boost::mutex::scoped_lock lock(mutex);
+	if (dirty) {
+		write(lock);
+	}
+}
+
+void StaticTransformSnapshot::shutdown() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (!running) {
+			return;
+		}
+		running = false;
+	}
+	condition.notify_all();
+	writer.join();
+	flush();
+}
+
+void StaticTransformSnapshot::writeChanges() {
+	boost::mutex::scoped_lock lock(mutex);
+	while (running) {
+		if (!dirty) {
+			condition.wait(lock);
+			continue;
+		}
+		// collect the rest of a burst (e.g. a sync) into one write, every
+		// update of the burst notifies
+		boost::system_time deadline = boost::get_system_time() + boost::posix_time::seconds(1);
+		while (running && condition.timed_wait(lock, deadline)) {
+		}
+		if (running && dirty) {
+			write(lock);
+		}
+	}
+}
+
+void StaticTransformSnapshot::write(boost::mutex::scoped_lock& lock) {
+	// keep authorities other processes sharing the file know better
+	vector<Transform> adopted;
+	read(adopted);
+
+	// records not received for too long belong to frames or authorities that
+	// are gone
+	const boost::int64_t horizon = nowMicroseconds() - maxAge.total_microseconds();
+	map<string, AuthorityState>::iterator it = authorities.begin();
+	while (it != authorities.end()) {
+		AuthorityState& state = it->second;
+		map<string, TransformRecord>::iterator record = state.records.begin();
+		while (record != state.records.end()) {
+			if (state.received[record->first] < horizon) {
+				state.received.erase(record->first);
+				state.records.erase(record++);
+			} else {
+				++record;
+			}
+		}
+		if (state.records.empty()) {
+			authorities.erase(it++);
+		} else {
+			++it;
+		}
+	}
+
+	vector<AuthorityEntry> entries;
+	vector<TransformRecord> records;
+	vector<boost::int64_t> received;
+	for (it = authorities.begin(); it != authorities.end(); ++it) {
+		AuthorityEntry entry;
+		memset(&entry, 0, sizeof(AuthorityEntry));
+		if (!TransformRecord::copyName(it->first, entry.authority)) {
+			continue;
+		}
+		entry.version = it->second.version;
+		entry.firstRecord = records.size();
+		entry.recordCount = it->second.records.size();
+		map<string, TransformRecord>::const_iterator record;
+		for (record = it->second.records.begin(); record != it->second.records.end(); ++record) {
+			records.push_back(record->second);
+			received.push_back(it->second.received.find(record->first)->second);
+		}
+		entries.push_back(entry);
+	}
+	dirty = false;
+
+	// the file is written without blocking the listener
+	lock.unlock();
+	bool written = writeFile(entries, records, received);
+	lock.lock();
+	if (!written) {
+		dirty = true;
+	}
+}
+
+bool StaticTransformSnapshot::writeFile(const vector<AuthorityEntry>& entries,
+		const vector<TransformRecord>& records, const vector<boost::int64_t>& received) {
+	boost::mutex::scoped_lock lock(fileMutex);
+
+	FileHeader header;
+	memset(&header, 0, sizeof(FileHeader));
+	memcpy(header.magic, magic, sizeof(magic));
+	header.formatVersion = formatVersion;
+	header.recordSize = sizeof(TransformRecord);
+	header.authorityCount = entries.size();
+	header.recordCount = records.size();
+
+	stringstream tmp;
+	tmp << file << ".tmp." << getpid();
+	{
+		ofstream out(tmp.str().c_str(), ios::binary | ios::trunc);
+		out.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+		if (!entries.empty()) {
+			out.write(reinterpret_cast<const char*>(&entries[0]),
+					entries.size() * sizeof(AuthorityEntry));
+		}
+		if (!records.empty()) {
+			out.write(reinterpret_cast<const char*>(&records[0]),
+					records.size() * sizeof(TransformRecord));
+			out.write(reinterpret_cast<const char*>(&received[0]),
+					received.size() * sizeof(boost::int64_t));
+		}
+		if (!out) {
+			RSCERROR(logger, "Cannot write snapshot " << tmp.str());
+			return false;
+		}
+	}
+
+	boost::system::error_code error;
+	boost::filesystem::rename(tmp.str(), file, error);
+	if (error) {
+		RSCERROR(logger, "Cannot replace snapshot " << file << ". Reason: " << error.message());
+		boost::filesystem::remove(tmp.str(), error);
+		return false;
+	}
+	RSCDEBUG(logger, "Wrote " << records.size() << " static transforms to " << file);
+	return true;
+}
+
+void StaticTransformSnapshot::printContents(std::ostream& stream) const {
+	boost::mutex::scoped_lock lock(mutex);
+	stream << "file = " << file;
+	stream << ", #authorities = " << authorities.size();
+	stream << ", dirty = " << dirty;
+}
+
+}  // namespace rct
@@ -0,0 +1,115 @@
+/*
+ * StaticTransformSnapshot.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformListener.h"
+#include "TransformerCore.h"
+#include "TransformRecord.h"
+#include <rsc/runtime/Printable.h>
+#include <rsc/logging/Logger.h>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+#include <map>
+
+namespace rct {
+
+/**
+ * Keeps the static transforms received by a process in a file, so that a
+ * restarted receiver can use static chains before its peers answered the
+ * sync request.
+ *
+ * The file holds a table of authorities, each with a version counter that
+ * increases whenever one of its static transforms changes, followed by the
+ * TransformRecords of all authorities and the time each record was last
+ * received. Records not received again (e.g. republished on a sync) within
+ * the maximum age are dropped, so frames and authorities that are gone do
+ * not stay in the file forever. It is memory-mapped for reading and
+ * replaced atomically (write to a temporary file, then rename) by a
+ * background thread at most once per second. Several processes may share
+ * a file: before writing, authorities with a higher version in the file
+ * are adopted from it.
+ *
+ * Transforms loaded from the snapshot are overwritten by live data as usual.
+ */
+class StaticTransformSnapshot: public TransformListener,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<StaticTransformSnapshot> Ptr;
+
+	StaticTransformSnapshot(const std::string& file,
+			const boost::posix_time::time_duration& maxAge = boost::posix_time::hours(24 * 7));
+	virtual ~StaticTransformSnapshot();
+
+	/** \brief Read the file and apply its transforms to the core.
+	 * A missing or invalid file is ignored.
+	 * \return number of transforms applied
+	 */
+	size_t load(const TransformerCore::Ptr& core);
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic);
+
+	/** \brief Write pending changes now */
+	void flush();
+	/** \brief Write pending changes and stop the background writer */
+	void shutdown();
+
+	void printContents(std::ostream& stream) const;
+
+	struct FileHeader {
+		char magic[8];
+		boost::uint32_t formatVersion;
+		boost::uint32_t recordSize;
+		boost::uint32_t authorityCount;
+		boost::uint32_t recordCount;
+	};
+
+	struct AuthorityEntry {
+		char authority[TransformRecord::nameSize];
+		boost::uint64_t version;
+		boost::uint32_t firstRecord;
+		boost::uint32_t recordCount;
+	};
+
+private:
+	class AuthorityState {
+	public:
+		AuthorityState() :
+				version(0) {
+		}
+		boost::uint64_t version;
+		// child frame -> record
+		std::map<std::string, TransformRecord> records;
+		// child frame -> wall clock time the record was last received, microseconds
+		std::map<std::string, boost::int64_t> received;
+	};
+
+	std::string file;
+	boost::posix_time::time_duration maxAge;
+	// guards the state, fileMutex serializes writing the file
+	mutable boost::mutex mutex;
+	boost::mutex fileMutex;
+	boost::condition_variable condition;
+	std::map<std::string, AuthorityState> authorities;
+	bool dirty;
+	bool running;
+	boost::thread writer;
+
+	static rsc::logging::LoggerPtr logger;
+
+	bool update(const Transform& transform);
+	void read(std::vector<Transform>& adopted);
+	void write(boost::mutex::scoped_lock& lock);
+	bool writeFile(const std::vector<AuthorityEntry>& entries,
+			const std::vector<TransformRecord>& records,
+			const std::vector<boost::int64_t>& received);
+	void writeChanges();
+};
+
+}  // namespace rct
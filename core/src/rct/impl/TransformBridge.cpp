@@ -0,0 +1,129 @@
+/*
+ * TransformBridge.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformBridge.h"
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformBridge::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformBridge");
+
+/**
+ * Listener registered at one communicator, tags transforms with their origin.
+ */
+class TransformBridge::Port: public TransformListener {
+public:
+	Port(const TransformBridge::Ptr& bridge, size_t index) :
+			bridge(bridge), index(index) {
+	}
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic) {
+		bridge->receive(index, vector<Transform>(1, transform), isStatic);
+	}
+
+	virtual void newTransformsAvailable(const vector<Transform>& transforms, bool isStatic) {
+		bridge->receive(index, transforms, isStatic);
+	}
+
+	void printContents(std::ostream& stream) const {
+		stream << "port = " << index;
+	}
+
+private:
+	TransformBridge::Ptr bridge;
+	size_t index;
+};
+
+TransformBridge::TransformBridge(const vector<TransformListener::Ptr>& listeners, bool forward,
+		size_t capacity) :
+		forward(forward), capacity(std::max<size_t>(1, capacity)), duplicates(0), forwarded(0) {
+	downstream.add(listeners);
+}
+
+TransformBridge::~TransformBridge() {
+}
+
+void TransformBridge::attach(const TransformCommunicator::Ptr& comm) {
+	size_t index;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		index = comms.size();
+		comms.push_back(comm);
+	}
+	// the communicators keep the bridge alive, the bridge only refers to them
+	comm->addTransformListener(TransformListener::Ptr(new Port(shared_from_this(), index)));
+}
+
+void TransformBridge::receive(size_t port, const vector<Transform>& transforms, bool isStatic) {
+	vector<Transform> fresh;
+	vector<TransformCommunicator::Ptr> targets;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		fresh.reserve(transforms.size());
+		vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			pair<map<Key, size_t>::iterator, bool> inserted = seen.insert(make_pair(Key(*it), port));
+			if (!inserted.second) {
+				if (inserted.first->second != port) {
+					duplicates++;
+					continue;
+				}
+				// sent again by its source, e.g. answering a sync
+				fresh.push_back(*it);
+				continue;
+			}
+			order.push_back(inserted.first);
+			if (order.size() > capacity) {
+				seen.erase(order.front());
+				order.pop_front();
+			}
+			fresh.push_back(*it);
+		}
+		if (fresh.empty()) {
+			RSCTRACE(logger, "Dropped " << transforms.size() << " duplicates from port " << port);
+			return;
+		}
+		if (forward) {
+			for (size_t i = 0; i < comms.size(); ++i) {
+				TransformCommunicator::Ptr comm = comms[i].lock();
+				if (i != port && comm) {
+					targets.push_back(comm);
+				}
+			}
+			forwarded += fresh.size() * targets.size();
+		}
+	}
+
+	try {
+		downstream.notify(fresh, isStatic);
+	} catch (std::exception &e) {
+		RSCERROR(logger, "Listener failed to apply transforms. Reason: " << e.what());
+	}
+
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = targets.begin(); it != targets.end(); ++it) {
+		try {
+			(*it)->sendTransform(fresh, isStatic ? STATIC : DYNAMIC);
+		} catch (std::exception &e) {
+			RSCWARN(logger, "Can not forward transforms. Reason: " << e.what());
+		}
+	}
+}
+
+unsigned long TransformBridge::getDuplicates() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return duplicates;
+}
+
+unsigned long TransformBridge::getForwarded() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return forwarded;
+}
+
+}  // namespace rct
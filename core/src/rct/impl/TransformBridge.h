@@ -0,0 +1,102 @@
+/*
+ * TransformBridge.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformCommunicator.h"
+#include "TransformListenerList.h"
+#include <rsc/logging/Logger.h>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/weak_ptr.hpp>
+#include <deque>
+#include <map>
+
+namespace rct {
+
+/**
+ * Joins the transforms received by several communicators, e.g. RSB and
+ * ROS, into one stream for the listeners of a receiver.
+ *
+ * A transform arriving through more than one transport is delivered once.
+ * Transforms are identified by authority, parent and child frame and
+ * stamp; the most recent identities are remembered with the communicator
+ * they arrived through first. Only the same identity arriving through
+ * another communicator is a duplicate, so transforms sent again through
+ * the same one (e.g. answering a sync) are delivered. Optionally every
+ * transform delivered is forwarded to all other communicators, which
+ * bridges the transports in-process. Echoes of forwarded transforms are
+ * duplicates and are neither delivered nor forwarded again.
+ */
+class TransformBridge: public boost::enable_shared_from_this<TransformBridge>,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformBridge> Ptr;
+
+	/**
+	 * \param forward send transforms received through one communicator
+	 *                with all others
+	 * \param capacity number of identities remembered for deduplication
+	 */
+	TransformBridge(const std::vector<TransformListener::Ptr>& listeners, bool forward,
+			size_t capacity = 16384);
+	virtual ~TransformBridge();
+
+	/** \brief Receive from the communicator and forward to it */
+	void attach(const TransformCommunicator::Ptr& comm);
+
+	/** \brief Number of transforms dropped as duplicates */
+	unsigned long getDuplicates() const;
+
+	/** \brief Number of transforms sent to other communicators */
+	unsigned long getForwarded() const;
+
+private:
+	class Key {
+	public:
+		Key(const Transform& transform) :
+				authority(transform.getAuthority()), parent(transform.getFrameParent()), child(
+						transform.getFrameChild()), time(transform.getTime()) {
+		}
+		std::string authority;
+		std::string parent;
+		std::string child;
+		boost::posix_time::ptime time;
+		bool operator<(const Key& k) const {
+			if (time != k.time) {
+				return time < k.time;
+			}
+			if (child != k.child) {
+				return child < k.child;
+			}
+			if (parent != k.parent) {
+				return parent < k.parent;
+			}
+			return authority < k.authority;
+		}
+	};
+
+	class Port;
+
+	TransformListenerList downstream;
+	bool forward;
+	size_t capacity;
+
+	mutable boost::mutex mutex;
+	// identity -> port it arrived through first
+	std::map<Key, size_t> seen;
+	// insertion order of seen, oldest first
+	std::deque<std::map<Key, size_t>::iterator> order;
+	std::vector<boost::weak_ptr<TransformCommunicator> > comms;
+	unsigned long duplicates;
+	unsigned long forwarded;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void receive(size_t port, const std::vector<Transform>& transforms, bool isStatic);
+};
+
+}  // namespace rct
@@ -0,0 +1,182 @@
+/*
+ * TransformChainResolver.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformChainResolver.h"
+#include <tf2/exceptions.h>
+
+using namespace std;
+
+namespace rct {
+
+static const unsigned int maxChainDepth = 1000;
+
+TransformChainResolver::TransformChainResolver(const EdgeSource& source) :
+		source(source) {
+}
+
+TransformChainResolver::~TransformChainResolver() {
+}
+
+bool TransformChainResolver::isLatest(const boost::posix_time::ptime& time) {
+	const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	return time.is_special() || time <= epoch;
+}
+
+void TransformChainResolver::checkFrame(const string& frame, const char* argument) const {
+	if (frame.empty()) {
+		throw tf2::InvalidArgumentException(
+				string("Invalid argument passed to lookupTransform argument ") + argument
+						+ ": frame id is empty");
+	}
+	if (!source.frameExists(frame)) {
+		throw tf2::LookupException(
+				"\"" + frame + "\" passed to lookupTransform argument " + argument
+						+ " does not exist. ");
+	}
+}
+
+bool TransformChainResolver::step(vector<Link>& chain, const boost::posix_time::ptime& time,
+		string& extrapolation) const {
+	Edge edge;
+	try {
+		if (!source.getEdge(chain.back().frame, time, edge)) {
+			return false;
+		}
+	} catch (tf2::ExtrapolationException &e) {
+		// the chain ends here, the lookup fails only if it needed this edge
+		if (extrapolation.empty()) {
+			extrapolation = e.what();
+		}
+		return false;
+	}
+	if (chain.size() > maxChainDepth) {
+		throw tf2::LookupException(
+				"The tf tree is invalid because it contains a loop at " + chain.front().frame);
+	}
+	Link link;
+	link.frame = edge.parent;
+	link.transform = edge.transform * chain.back().transform;
+	if (!edge.isStatic) {
+		link.time = edge.time;
+	}
+	chain.push_back(link);
+	return true;
+}
+
+Transform TransformChainResolver::resolve(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time, boost::posix_time::ptime& latest) const {
+
+	Link start;
+	start.transform = Eigen::Affine3d::Identity();
+
+	string extrapolation;
+	vector<Link> sourceChain;
+	start.frame = source_frame;
+	sourceChain.push_back(start);
+	while (sourceChain.back().frame != target_frame && step(sourceChain, time, extrapolation)) {
+	}
+
+	vector<Link> targetChain;
+	start.frame = target_frame;
+	targetChain.push_back(start);
+	do {
+		for (size_t s = 0; s < sourceChain.size(); ++s) {
+			if (targetChain.back().frame == sourceChain[s].frame) {
+				// common ancestor found, target <- ancestor <- source
+				earliest(sourceChain, s + 1, latest);
+				earliest(targetChain, targetChain.size(), latest);
+				Eigen::Affine3d a = targetChain.back().transform.inverse()
+						* sourceChain[s].transform;
+				return Transform(a, target_frame, source_frame, isLatest(time) ? latest : time);
+			}
+		}
+	} while (step(targetChain, time, extrapolation));
+
+	if (!extrapolation.empty()) {
+		throw tf2::ExtrapolationException(extrapolation);
+	}
+	throw tf2::ConnectivityException(
+			"Could not find a connection between '" + target_frame + "' and '" + source_frame
+					+ "' because they are not part of the same tree.");
+}
+
+void TransformChainResolver::earliest(const vector<Link>& chain, size_t end,
+		boost::posix_time::ptime& latest) {
+	for (size_t i = 0; i < end; ++i) {
+		const boost::posix_time::ptime& time = chain[i].time;
+		if (!time.is_special() && (latest.is_special() || time < latest)) {
+			latest = time;
+		}
+	}
+}
+
+Transform TransformChainResolver::lookupTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) const {
+	checkFrame(target_frame, "target_frame");
+	checkFrame(source_frame, "source_frame");
+
+	boost::posix_time::ptime latest;
+	Transform result = resolve(target_frame, source_frame, time, latest);
+	if (isLatest(time) && !latest.is_special()) {
+		// evaluate all edges at the latest time common to the chain
+		boost::posix_time::ptime unused;
+		result = resolve(target_frame, source_frame, latest, unused);
+	}
+	return result;
+}
+
+Transform TransformChainResolver::lookupTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame) const {
+	checkFrame(fixed_frame, "fixed_frame");
+	Transform fixedToTarget = lookupTransform(target_frame, fixed_frame, target_time);
+	Transform sourceToFixed = lookupTransform(fixed_frame, source_frame, source_time);
+	return Transform(fixedToTarget.getTransform() * sourceToFixed.getTransform(), target_frame,
+			source_frame, fixedToTarget.getTime());
+}
+
+bool TransformChainResolver::canTransform(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time, string* error_msg) const {
+	try {
+		lookupTransform(target_frame, source_frame, time);
+		return true;
+	} catch (tf2::TransformException &e) {
+		if (error_msg) {
+			*error_msg = e.what();
+		}
+		return false;
+	}
+}
+
+bool TransformChainResolver::canTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame,
+		string* error_msg) const {
+	try {
+		lookupTransform(target_frame, target_time, source_frame, source_time, fixed_frame);
+		return true;
+	} catch (tf2::TransformException &e) {
+		if (error_msg) {
+			*error_msg = e.what();
+		}
+		return false;
+	}
+}
+
+string TransformChainResolver::getParent(const string& frame,
+		const boost::posix_time::ptime& time) const {
+	Edge edge;
+	try {
+		if (source.getEdge(frame, time, edge)) {
+			return edge.parent;
+		}
+	} catch (tf2::TransformException &e) {
+	}
+	return "";
+}
+
+}  // namespace rct
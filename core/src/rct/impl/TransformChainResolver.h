@@ -0,0 +1,98 @@
+/*
+ * TransformChainResolver.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "../Transform.h"
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Resolves lookups between two frames by composing the edges of the frame
+ * tree, for cores that do not store their data in a tf2::BufferCore.
+ *
+ * The edges are provided by an EdgeSource. Lookups follow the semantics of
+ * tf2: a time of 0 (or not_a_date_time) evaluates the whole chain at the
+ * latest time all its dynamic edges have data for, and failures are
+ * reported by the tf2 exceptions.
+ */
+class TransformChainResolver {
+public:
+	class Edge {
+	public:
+		std::string parent;
+		Eigen::Affine3d transform;
+		boost::posix_time::ptime time;
+		bool isStatic;
+	};
+
+	class EdgeSource {
+	public:
+		virtual ~EdgeSource() {
+		}
+
+		/** \brief Get the edge from a frame to its parent.
+		 * \param time Time to interpolate the edge at, latest if special
+		 * \return false if the frame has no parent
+		 * \throw tf2::ExtrapolationException if no data exists for the time
+		 */
+		virtual bool getEdge(const std::string& frame, const boost::posix_time::ptime& time,
+				Edge& edge) const = 0;
+
+		virtual bool frameExists(const std::string& frame) const = 0;
+	};
+
+	TransformChainResolver(const EdgeSource& source);
+	virtual ~TransformChainResolver();
+
+	Transform lookupTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time) const;
+
+	Transform lookupTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame) const;
+
+	bool canTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time, std::string* error_msg = NULL) const;
+
+	bool canTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame,
+			std::string* error_msg = NULL) const;
+
+	/** \brief The parent of a frame at the given time, empty if it has none */
+	std::string getParent(const std::string& frame, const boost::posix_time::ptime& time) const;
+
+	/** \return true if the time means "latest" */
+	static bool isLatest(const boost::posix_time::ptime& time);
+
+private:
+	class Link {
+	public:
+		std::string frame;
+		// frame to the first frame of the chain
+		Eigen::Affine3d transform;
+		// time of the edge leading to this frame, special if static
+		boost::posix_time::ptime time;
+	};
+
+	const EdgeSource& source;
+
+	void checkFrame(const std::string& frame, const char* argument) const;
+	static void earliest(const std::vector<Link>& chain, size_t end,
+			boost::posix_time::ptime& latest);
+
+	bool step(std::vector<Link>& chain, const boost::posix_time::ptime& time,
+			std::string& extrapolation) const;
+	Transform resolve(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time, boost::posix_time::ptime& latest) const;
+};
+
+}  // namespace rct
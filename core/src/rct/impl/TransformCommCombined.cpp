@@ -0,0 +1,109 @@
+/*
+ * TransformCommCombined.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformCommCombined.h"
+
+using namespace std;
+
+namespace rct {
+
+TransformCommCombined::TransformCommCombined(const vector<TransformCommunicator::Ptr>& comms) :
+		comms(comms) {
+	if (comms.empty()) {
+		throw std::invalid_argument("No communicators to combine");
+	}
+}
+
+TransformCommCombined::TransformCommCombined(const TransformCommunicator::Ptr& first,
+		const TransformCommunicator::Ptr& second) {
+	comms.push_back(first);
+	comms.push_back(second);
+}
+
+TransformCommCombined::~TransformCommCombined() {
+}
+
+void TransformCommCombined::init(const TransformerConfig &conf) {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->init(conf);
+	}
+}
+
+void TransformCommCombined::shutdown() {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->shutdown();
+	}
+}
+
+void TransformCommCombined::flush() {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->flush();
+	}
+}
+
+bool TransformCommCombined::sendTransform(const Transform& transform, TransformType type) {
+	bool result = true;
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		result = (*it)->sendTransform(transform, type) && result;
+	}
+	return result;
+}
+
+bool TransformCommCombined::sendTransform(const vector<Transform>& transforms,
+		TransformType type) {
+	bool result = true;
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		result = (*it)->sendTransform(transforms, type) && result;
+	}
+	return result;
+}
+
+void TransformCommCombined::addTransformListener(const TransformListener::Ptr& listener) {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->addTransformListener(listener);
+	}
+}
+
+void TransformCommCombined::addTransformListener(const vector<TransformListener::Ptr>& listeners) {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->addTransformListener(listeners);
+	}
+}
+
+void TransformCommCombined::removeTransformListener(const TransformListener::Ptr& listener) {
+	vector<TransformCommunicator::Ptr>::iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		(*it)->removeTransformListener(listener);
+	}
+}
+
+void TransformCommCombined::printContents(std::ostream& stream) const {
+	stream << "communicators = [";
+	vector<TransformCommunicator::Ptr>::const_iterator it;
+	for (it = comms.begin(); it != comms.end(); ++it) {
+		if (it != comms.begin()) {
+			stream << ", ";
+		}
+		stream << "{";
+		(*it)->printContents(stream);
+		stream << "}";
+	}
+	stream << "]";
+}
+
+string TransformCommCombined::getAuthorityName() const {
+	return comms.front()->getAuthorityName();
+}
+
+}  // namespace rct
@@ -0,0 +1,51 @@
+/*
+ * TransformCommCombined.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformCommunicator.h"
+#include <vector>
+
+namespace rct {
+
+/**
+ * Uses several communicators as one: transforms are sent through all of
+ * them and listeners are registered at all of them.
+ *
+ * The communicators have to avoid delivering the same transform twice
+ * themselves, e.g. a network communicator combined with a
+ * TransformCommLoopback ignores messages from its own process.
+ */
+class TransformCommCombined: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<TransformCommCombined> Ptr;
+	TransformCommCombined(const std::vector<TransformCommunicator::Ptr>& comms);
+	TransformCommCombined(const TransformCommunicator::Ptr& first,
+			const TransformCommunicator::Ptr& second);
+	virtual ~TransformCommCombined();
+
+	virtual void init(const TransformerConfig &conf);
+	virtual void shutdown();
+
+	virtual bool sendTransform(const Transform& transform, TransformType type);
+	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
+	virtual void flush();
+
+	virtual void addTransformListener(const TransformListener::Ptr& listener);
+	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
+	virtual void removeTransformListener(const TransformListener::Ptr& listener);
+
+	void printContents(std::ostream& stream) const;
+
+	/** \brief The authority of the first communicator */
+	virtual std::string getAuthorityName() const;
+
+private:
+	std::vector<TransformCommunicator::Ptr> comms;
+};
+
+}  // namespace rct
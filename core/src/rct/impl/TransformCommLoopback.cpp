@@ -0,0 +1,198 @@
+/*
+ * TransformCommLoopback.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformCommLoopback.h"
+#include <rsc/misc/UUID.h>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformCommLoopback::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformCommLoopback");
+
+class TransformCommLoopback::Hub {
+public:
+	typedef std::pair<const TransformCommLoopback*, boost::shared_ptr<TransformListenerList> > Member;
+	typedef std::vector<Member> Members;
+
+	void join(const TransformCommLoopback* owner,
+			const boost::shared_ptr<TransformListenerList>& listeners) {
+		boost::mutex::scoped_lock lock(mutex);
+		boost::shared_ptr<Members> next(new Members(*members));
+		next->push_back(make_pair(owner, listeners));
+		members = next;
+	}
+
+	void leave(const TransformCommLoopback* owner) {
+		boost::mutex::scoped_lock lock(mutex);
+		boost::shared_ptr<Members> next(new Members());
+		Members::const_iterator it;
+		for (it = members->begin(); it != members->end(); ++it) {
+			if (it->first != owner) {
+				next->push_back(*it);
+			}
+		}
+		members = next;
+	}
+
+	void publish(const TransformCommLoopback* sender, const vector<Transform>& transforms,
+			bool isStatic) {
+		boost::shared_ptr<const Members> current;
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			if (isStatic) {
+				vector<Transform>::const_iterator t;
+				for (t = transforms.begin(); t != transforms.end(); ++t) {
+					statics[t->getFrameChild()] = *t;
+				}
+			}
+			current = members;
+		}
+		// delivered outside the lock, listeners may send themselves
+		Members::const_iterator it;
+		for (it = current->begin(); it != current->end(); ++it) {
+			if (it->first != sender) {
+				it->second->notify(transforms, isStatic);
+			}
+		}
+	}
+
+	void replay(const TransformListenerList& listeners) {
+		vector<Transform> staticTransforms;
+		{
+			boost::mutex::scoped_lock lock(mutex);
+			staticTransforms.reserve(statics.size());
+			map<string, Transform>::const_iterator it;
+			for (it = statics.begin(); it != statics.end(); ++it) {
+				staticTransforms.push_back(it->second);
+			}
+		}
+		if (!staticTransforms.empty()) {
+			listeners.notify(staticTransforms, true);
+		}
+	}
+
+	size_t size() const {
+		boost::mutex::scoped_lock lock(mutex);
+		return members->size();
+	}
+
+	Hub() :
+			members(new Members()) {
+	}
+
+private:
+	mutable boost::mutex mutex;
+	// copy-on-write like TransformListenerList
+	boost::shared_ptr<const Members> members;
+	// latest static transform by child frame, a frame has a single parent.
+	// Dynamic transforms are not kept, publishers resend them anyway.
+	map<string, Transform> statics;
+};
+
+TransformCommLoopback::Hub& TransformCommLoopback::getHub() {
+	static Hub hub;
+	return hub;
+}
+
+const string& TransformCommLoopback::getProcessId() {
+	static const string id = rsc::misc::UUID().getIdAsString();
+	return id;
+}
+
+TransformCommLoopback::TransformCommLoopback(const string &authority) :
+		authority(authority), listeners(new TransformListenerList()), joined(false) {
+}
+
+TransformCommLoopback::TransformCommLoopback(const string &authority,
+		const TransformListener::Ptr& l) :
+		authority(authority), listeners(new TransformListenerList()), joined(false) {
+	addTransformListener(l);
+}
+
+TransformCommLoopback::TransformCommLoopback(const string &authority,
+		const vector<TransformListener::Ptr>& l) :
+		authority(authority), listeners(new TransformListenerList()), joined(false) {
+	addTransformListener(l);
+}
+
+TransformCommLoopback::~TransformCommLoopback() {
+	shutdown();
+}
+
+void TransformCommLoopback::init(const TransformerConfig &conf) {
+	RSCDEBUG(logger, "init()");
+	getHub().join(this, listeners);
+	joined = true;
+	requestSync();
+}
+
+void TransformCommLoopback::shutdown() {
+	listeners->clear();
+	if (joined) {
+		getHub().leave(this);
+		joined = false;
+	}
+}
+
+void TransformCommLoopback::requestSync() {
+	if (!joined) {
+		throw std::runtime_error("communicator was not initialized!");
+	}
+	getHub().replay(*listeners);
+}
+
+bool TransformCommLoopback::sendTransform(const Transform& transform, TransformType type) {
+	return sendTransform(vector<Transform>(1, transform), type);
+}
+
+bool TransformCommLoopback::sendTransform(const vector<Transform>& transforms,
+		TransformType type) {
+	if (!joined) {
+		throw std::runtime_error("communicator was not initialized!");
+	}
+	if (type != STATIC && type != DYNAMIC) {
+		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
+		return false;
+	}
+	vector<Transform> sent(transforms);
+	vector<Transform>::iterator it;
+	for (it = sent.begin(); it != sent.end(); ++it) {
+		if (it->getAuthority() == "") {
+			it->setAuthority(authority);
+		}
+	}
+	RSCTRACE(logger, "Publishing " << sent.size() << " transforms");
+	getHub().publish(this, sent, type == STATIC);
+	return true;
+}
+
+void TransformCommLoopback::addTransformListener(const TransformListener::Ptr& l) {
+	listeners->add(l);
+}
+
+void TransformCommLoopback::addTransformListener(const vector<TransformListener::Ptr>& l) {
+	listeners->add(l);
+}
+
+void TransformCommLoopback::removeTransformListener(const TransformListener::Ptr& l) {
+	listeners->remove(l);
+}
+
+void TransformCommLoopback::printContents(std::ostream& stream) const {
+	stream << "authority = " << authority;
+	stream << ", communication = loopback";
+	stream << ", #listeners = " << listeners->size();
+	stream << ", #peers = " << getHub().size();
+}
+
+string TransformCommLoopback::getAuthorityName() const {
+	return authority;
+}
+
+}  // namespace rct
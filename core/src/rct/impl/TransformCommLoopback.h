@@ -0,0 +1,69 @@
+/*
+ * TransformCommLoopback.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformCommunicator.h"
+#include "TransformListenerList.h"
+#include <rsc/logging/Logger.h>
+#include <map>
+
+namespace rct {
+
+/**
+ * Delivers transforms to the listeners of all other loopback communicators
+ * of the same process, without any serialization.
+ *
+ * All instances of a process share one hub. The hub keeps the latest
+ * static transform of every frame, which newly initialized communicators
+ * receive like the answer to a sync request. Combined with a network communicator
+ * (see TransformCommCombined) local peers are served by the loopback and
+ * remote peers by the network. It also is a deterministic backend for
+ * benchmarks and tests that must not touch the network.
+ */
+class TransformCommLoopback: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<TransformCommLoopback> Ptr;
+	TransformCommLoopback(const std::string &authority);
+	TransformCommLoopback(const std::string &authority, const TransformListener::Ptr& listener);
+	TransformCommLoopback(const std::string &authority,
+			const std::vector<TransformListener::Ptr>& listeners);
+	virtual ~TransformCommLoopback();
+
+	virtual void init(const TransformerConfig &conf);
+	virtual void shutdown();
+	virtual void requestSync();
+
+	virtual bool sendTransform(const Transform& transform, TransformType type);
+	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
+
+	virtual void addTransformListener(const TransformListener::Ptr& listener);
+	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
+	virtual void removeTransformListener(const TransformListener::Ptr& listener);
+
+	void printContents(std::ostream& stream) const;
+
+	virtual std::string getAuthorityName() const;
+
+	/** \brief Random id of this process. Network communicators use it to
+	 * ignore messages already delivered by the loopback.
+	 */
+	static const std::string& getProcessId();
+
+private:
+	class Hub;
+
+	std::string authority;
+	boost::shared_ptr<TransformListenerList> listeners;
+	bool joined;
+
+	static rsc::logging::LoggerPtr logger;
+
+	static Hub& getHub();
+};
+
+}  // namespace rct
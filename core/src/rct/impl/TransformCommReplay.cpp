@@ -0,0 +1,218 @@
+/*
+ * TransformCommReplay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformCommReplay.h"
+
+using namespace std;
+using namespace boost::posix_time;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformCommReplay::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformCommReplay");
+
+static const size_t maxBatchSize = 256;
+// upper bound for a single sleep, so shutdown is not delayed by long gaps
+static const time_duration maxSleep = milliseconds(100);
+
+TransformCommReplay::TransformCommReplay(const string &authority) :
+		authority(authority), speed(1.0), start(seconds(0)), restamp(false), running(false), finished(
+				false), replayed(0) {
+}
+
+TransformCommReplay::TransformCommReplay(const string &authority,
+		const TransformListener::Ptr& l) :
+		authority(authority), speed(1.0), start(seconds(0)), restamp(false), running(false), finished(
+				false), replayed(0) {
+	addTransformListener(l);
+}
+
+TransformCommReplay::TransformCommReplay(const string &authority,
+		const vector<TransformListener::Ptr>& l) :
+		authority(authority), speed(1.0), start(seconds(0)), restamp(false), running(false), finished(
+				false), replayed(0) {
+	addTransformListener(l);
+}
+
+TransformCommReplay::~TransformCommReplay() {
+	shutdown();
+}
+
+void TransformCommReplay::init(const TransformerConfig &conf) {
+	RSCDEBUG(logger, "init()");
+	file = conf.getReplayFile();
+	speed = std::max(0.0, conf.getReplaySpeed());
+	start = conf.getReplayStart();
+	restamp = conf.isReplayRestamp();
+
+	if (file.empty()) {
+		throw std::invalid_argument("No replay file configured");
+	}
+	reader = TransformLogReader::Ptr(new TransformLogReader(file));
+
+	running = true;
+	player = boost::thread(&TransformCommReplay::play, this);
+}
+
+void TransformCommReplay::shutdown() {
+	listeners.clear();
+	if (!running.exchange(false)) {
+		return;
+	}
+	if (player.joinable() && player.get_id() != boost::this_thread::get_id()) {
+		player.join();
+	}
+}
+
+void TransformCommReplay::requestSync() {
+	vector<Transform> transforms;
+	{
+		boost::mutex::scoped_lock lock(staticsMutex);
+		map<string, Transform>::const_iterator it;
+		for (it = statics.begin(); it != statics.end(); ++it) {
+			transforms.push_back(it->second);
+		}
+	}
+	RSCDEBUG(logger, "Delivering " << transforms.size() << " static transforms");
+	if (!transforms.empty()) {
+		deliver(transforms, true);
+	}
+}
+
+bool TransformCommReplay::sendTransform(const Transform& transform, TransformType type) {
+	RSCWARN(logger, "Cannot send transform. Reason: replay communicator is read-only");
+	return false;
+}
+
+bool TransformCommReplay::sendTransform(const vector<Transform>& transforms,
+		TransformType type) {
+	RSCWARN(logger, "Cannot send transforms. Reason: replay communicator is read-only");
+	return false;
+}
+
+void TransformCommReplay::play() {
+	vector<Transform> transforms;
+	transforms.reserve(maxBatchSize);
+
+	ptime logStart = reader->getStartTime();
+	if (!logStart.is_special() && start > seconds(0)) {
+		reader->seek(logStart + start, transforms);
+		RSCDEBUG(logger, "Starting replay at " << (logStart + start));
+		deliver(transforms, true);
+	}
+
+	ptime first;
+	ptime wallStart;
+	ptime received;
+	Transform transform;
+	bool isStatic;
+
+	while (running) {
+		if (!reader->next(transform, isStatic, received)) {
+			break;
+		}
+
+		if (isStatic) {
+			deliver(transforms, false);
+			transforms.push_back(transform);
+			deliver(transforms, true);
+			continue;
+		}
+
+		ptime now = microsec_clock::universal_time();
+		if (first.is_special()) {
+			first = received;
+			wallStart = now;
+		}
+		ptime due = now;
+		if (speed > 0.0) {
+			due = wallStart
+					+ microseconds(
+							boost::int64_t(
+									double((received - first).total_microseconds())
+											/ speed));
+			if (due > now) {
+				// hand out what is due before waiting
+				deliver(transforms, false);
+			}
+			while (running && due > now) {
+				boost::this_thread::sleep(std::min<time_duration>(due - now, maxSleep));
+				now = microsec_clock::universal_time();
+			}
+		}
+		if (restamp) {
+			transform.setTime(due);
+		}
+
+		transforms.push_back(transform);
+		if (transforms.size() >= maxBatchSize) {
+			deliver(transforms, false);
+		}
+	}
+	deliver(transforms, false);
+
+	if (running) {
+		RSCINFO(logger, "Replay of " << file << " finished after " << replayed << " transforms");
+	}
+	finished = true;
+}
+
+void TransformCommReplay::deliver(vector<Transform>& transforms, bool isStatic) {
+	if (transforms.empty()) {
+		return;
+	}
+	if (isStatic) {
+		boost::mutex::scoped_lock lock(staticsMutex);
+		vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			statics[it->getFrameChild()] = *it;
+		}
+	}
+	try {
+		listeners.notify(transforms, isStatic);
+	} catch (std::exception &e) {
+		RSCERROR(logger, "Listener failed to apply transforms. Reason: " << e.what());
+	}
+	replayed += transforms.size();
+	transforms.clear();
+}
+
+void TransformCommReplay::addTransformListener(const TransformListener::Ptr& l) {
+	listeners.add(l);
+}
+
+void TransformCommReplay::addTransformListener(const vector<TransformListener::Ptr>& l) {
+	listeners.add(l);
+}
+
+void TransformCommReplay::removeTransformListener(const TransformListener::Ptr& l) {
+	listeners.remove(l);
+}
+
+bool TransformCommReplay::isFinished() const {
+	return finished;
+}
+
+unsigned long TransformCommReplay::getReplayed() const {
+	return replayed;
+}
+
+void TransformCommReplay::printContents(std::ostream& stream) const {
+	stream << "authority = " << authority;
+	stream << ", communication = replay";
+	stream << ", file = " << file;
+	stream << ", speed = " << speed;
+	stream << ", #listeners = " << listeners.size();
+	stream << ", replayed = " << replayed;
+	stream << ", finished = " << finished;
+}
+
+string TransformCommReplay::getAuthorityName() const {
+	return authority;
+}
+
+}  // namespace rct
@@ -0,0 +1,88 @@
+/*
+ * TransformCommReplay.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformCommunicator.h"
+#include "TransformListenerList.h"
+#include "TransformLog.h"
+#include <rsc/logging/Logger.h>
+#include <boost/atomic.hpp>
+#include <map>
+
+namespace rct {
+
+/**
+ * Feeds the listeners from a TransformLog instead of a middleware.
+ *
+ * The log is replayed in real time, accelerated or slowed down by the
+ * configured speed, or as fast as possible with a speed of 0. Only
+ * dynamic transforms are paced, by the time the recorder received them,
+ * so delays and reordering of the live traffic are reproduced. Static
+ * transforms are delivered as soon as they are read. Optionally the stamps of dynamic transforms are
+ * shifted to the time of their delivery, so lookups of the current time
+ * work as with live data.
+ *
+ * The communicator can only receive.
+ */
+class TransformCommReplay: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<TransformCommReplay> Ptr;
+	TransformCommReplay(const std::string &authority);
+	TransformCommReplay(const std::string &authority, const TransformListener::Ptr& listener);
+	TransformCommReplay(const std::string &authority,
+			const std::vector<TransformListener::Ptr>& listeners);
+	virtual ~TransformCommReplay();
+
+	virtual void init(const TransformerConfig &conf);
+	virtual void shutdown();
+
+	/** \brief Deliver the static transforms replayed so far again */
+	virtual void requestSync();
+
+	/** \brief Not supported, always false */
+	virtual bool sendTransform(const Transform& transform, TransformType type);
+	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
+
+	virtual void addTransformListener(const TransformListener::Ptr& listener);
+	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
+	virtual void removeTransformListener(const TransformListener::Ptr& listener);
+
+	/** \brief true once the end of the log was reached */
+	bool isFinished() const;
+
+	/** \brief Number of transforms delivered so far */
+	unsigned long getReplayed() const;
+
+	void printContents(std::ostream& stream) const;
+
+	virtual std::string getAuthorityName() const;
+
+private:
+	std::string authority;
+	TransformListenerList listeners;
+	TransformLogReader::Ptr reader;
+	std::string file;
+	double speed;
+	boost::posix_time::time_duration start;
+	bool restamp;
+
+	boost::thread player;
+	boost::atomic<bool> running;
+	boost::atomic<bool> finished;
+	boost::atomic<unsigned long> replayed;
+
+	boost::mutex staticsMutex;
+	std::map<std::string, Transform> statics;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void play();
+	void deliver(std::vector<Transform>& transforms, bool isStatic);
+};
+
+}  // namespace rct
@@ -48,6 +48,12 @@ public:
 	 */
 	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type) = 0;
 
+	/** \brief Send transforms the communicator still holds back, e.g. to
+	 * aggregate them into fewer messages. Does nothing by default.
+	 */
+	virtual void flush() {
+	}
+
 	virtual void addTransformListener(const TransformListener::Ptr& listener) = 0;
 	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners) = 0;
 	virtual void removeTransformListener(const TransformListener::Ptr& listener) = 0;
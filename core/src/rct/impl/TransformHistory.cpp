@@ -0,0 +1,323 @@
+/*
+ * TransformHistory.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformHistory.h"
+#include "TransformLog.h"
+#include "TransformQuantizer.h"
+#include <tf2/exceptions.h>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+static string formatTime(boost::int64_t time) {
+	return boost::lexical_cast<string>(double(time) / 1e6);
+}
+
+TransformHistory::TransformHistory(const boost::posix_time::time_duration& historyTime,
+		double translationResolution, double rotationResolution, unsigned int blockSize) :
+		historyTime(historyTime.total_microseconds()), translationResolution(
+				translationResolution), rotationResolution(rotationResolution), blockSize(
+				std::max(1u, blockSize)), samples(0), rejected(0), newest(0), nextExpiry(0), resolver(
+				*this) {
+	if (translationResolution <= 0 || rotationResolution <= 0) {
+		throw std::invalid_argument("Quantization resolutions must be positive");
+	}
+}
+
+TransformHistory::~TransformHistory() {
+}
+
+void TransformHistory::add(const Transform& transform, bool isStatic) {
+	boost::mutex::scoped_lock lock(mutex);
+	append(transform, isStatic);
+}
+
+void TransformHistory::add(const vector<Transform>& transforms, bool isStatic) {
+	boost::mutex::scoped_lock lock(mutex);
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		append(*it, isStatic);
+	}
+}
+
+void TransformHistory::append(const Transform& transform, bool isStatic) {
+	if (isStatic) {
+		TransformChainResolver::Edge& edge = statics[transform.getFrameChild()];
+		edge.parent = transform.getFrameParent();
+		edge.transform = transform.getTransform();
+		edge.time = transform.getTime();
+		edge.isStatic = true;
+		return;
+	}
+
+	boost::int64_t time = toMicroseconds(transform.getTime());
+	if (time < newest - historyTime) {
+		rejected++;
+		return;
+	}
+	boost::uint32_t parent = names.encode(transform.getFrameParent());
+	Blocks& blocks = edges[transform.getFrameChild()];
+
+	if (!blocks.empty() && time < blocks.back().last) {
+		rejected++;
+		return;
+	}
+	if (blocks.empty() || blocks.back().count >= blockSize || blocks.back().parent != parent) {
+		if (!blocks.empty()) {
+			// sealed, release the spare capacity
+			string(blocks.back().data).swap(blocks.back().data);
+		}
+		blocks.push_back(Block());
+		Block& block = blocks.back();
+		block.first = time;
+		block.last = time;
+		block.parent = parent;
+		block.count = 0;
+		std::fill(block.values, block.values + 7, 0);
+	}
+
+	// the first sample of a block is a delta to zero, i.e. a keyframe
+	Block& block = blocks.back();
+	boost::int64_t values[7];
+	quantize(transform, translationResolution, rotationResolution, values);
+	TransformLog::writeVarint(block.data, TransformLog::zigzag(time - block.last));
+	for (int i = 0; i < 7; ++i) {
+		TransformLog::writeVarint(block.data, TransformLog::zigzag(values[i] - block.values[i]));
+		block.values[i] = values[i];
+	}
+	block.last = time;
+	block.count++;
+	samples++;
+
+	// edges that stopped receiving expire against the newest sample of all
+	newest = std::max(newest, time);
+	if (newest >= nextExpiry) {
+		expire(newest - historyTime);
+		nextExpiry = newest + std::max(historyTime / 16, boost::int64_t(1000000));
+	} else {
+		expire(blocks, newest - historyTime);
+	}
+}
+
+void TransformHistory::expire(boost::int64_t time) {
+	map<string, Blocks>::iterator it = edges.begin();
+	while (it != edges.end()) {
+		expire(it->second, time);
+		if (it->second.empty()) {
+			edges.erase(it++);
+		} else {
+			++it;
+		}
+	}
+}
+
+void TransformHistory::expire(Blocks& blocks, boost::int64_t time) {
+	while (!blocks.empty() && blocks.front().last < time) {
+		samples -= blocks.front().count;
+		blocks.pop_front();
+	}
+}
+
+void TransformHistory::decode(const Block& block, vector<Sample>& out) const {
+	out.resize(block.count);
+	const char* position = block.data.data();
+	const char* end = position + block.data.size();
+	boost::int64_t time = block.first;
+	boost::int64_t values[7] = { 0, 0, 0, 0, 0, 0, 0 };
+	boost::uint64_t value;
+	for (boost::uint32_t n = 0; n < block.count; ++n) {
+		TransformLog::readVarint(position, end, value);
+		time += TransformLog::unzigzag(value);
+		out[n].time = time;
+		for (int i = 0; i < 7; ++i) {
+			TransformLog::readVarint(position, end, value);
+			values[i] += TransformLog::unzigzag(value);
+			out[n].values[i] = values[i];
+		}
+	}
+}
+
+void TransformHistory::clear() {
+	boost::mutex::scoped_lock lock(mutex);
+	edges.clear();
+	statics.clear();
+	names.clear();
+	samples = 0;
+	newest = 0;
+	nextExpiry = 0;
+}
+
+bool TransformHistory::endsBefore(const Block& block, boost::int64_t time) {
+	return block.last < time;
+}
+
+bool TransformHistory::after(boost::int64_t time, const Sample& sample) {
+	return time < sample.time;
+}
+
+bool TransformHistory::getEdge(const string& frame, const boost::posix_time::ptime& time,
+		TransformChainResolver::Edge& edge) const {
+	boost::mutex::scoped_lock lock(mutex);
+
+	map<string, TransformChainResolver::Edge>::const_iterator s = statics.find(frame);
+	if (s != statics.end()) {
+		edge = s->second;
+		return true;
+	}
+	map<string, Blocks>::const_iterator e = edges.find(frame);
+	if (e == edges.end() || e->second.empty()) {
+		return false;
+	}
+	const Blocks& blocks = e->second;
+
+	Sample sample;
+	if (TransformChainResolver::isLatest(time)) {
+		sample.time = blocks.back().last;
+		std::copy(blocks.back().values, blocks.back().values + 7, sample.values);
+		toEdge(sample, blocks.back(), edge);
+		return true;
+	}
+
+	boost::int64_t t = toMicroseconds(time);
+	if (t > blocks.back().last) {
+		throw tf2::ExtrapolationException(
+				"Lookup would require extrapolation into the future.  Requested time "
+						+ formatTime(t) + " but the latest data is at time "
+						+ formatTime(blocks.back().last)
+						+ ", when looking up transform from frame [" + frame + "]");
+	}
+	if (t < blocks.front().first) {
+		throw tf2::ExtrapolationException(
+				"Lookup would require extrapolation into the past.  Requested time "
+						+ formatTime(t) + " but the earliest data is at time "
+						+ formatTime(blocks.front().first)
+						+ ", when looking up transform from frame [" + frame + "]");
+	}
+
+	Blocks::const_iterator block = std::lower_bound(blocks.begin(), blocks.end(), t, endsBefore);
+	vector<Sample> decoded;
+	decode(*block, decoded);
+	vector<Sample>::const_iterator high = std::upper_bound(decoded.begin(), decoded.end(), t,
+			after);
+
+	Sample low;
+	if (high == decoded.begin()) {
+		// between two blocks, the previous one ends with the lower sample
+		Blocks::const_iterator previous = block - 1;
+		if (previous->parent != block->parent) {
+			toEdge(*high, *block, edge);
+			return true;
+		}
+		low.time = previous->last;
+		std::copy(previous->values, previous->values + 7, low.values);
+	} else {
+		low = *(high - 1);
+	}
+	if (low.time == t || high == decoded.end()) {
+		toEdge(low, *block, edge);
+		return true;
+	}
+
+	double ratio = double(t - low.time) / double(high->time - low.time);
+	Eigen::Affine3d a = dequantize(low.values, translationResolution, rotationResolution);
+	Eigen::Affine3d b = dequantize(high->values, translationResolution, rotationResolution);
+	Eigen::Vector3d translation = a.translation() + ratio * (b.translation() - a.translation());
+	Eigen::Quaterniond rotation = Eigen::Quaterniond(a.rotation()).slerp(ratio,
+			Eigen::Quaterniond(b.rotation()));
+	edge.parent = names.getName(block->parent);
+	edge.transform = Eigen::Translation3d(translation) * rotation;
+	edge.time = time;
+	edge.isStatic = false;
+	return true;
+}
+
+void TransformHistory::toEdge(const Sample& sample, const Block& block,
+		TransformChainResolver::Edge& edge) const {
+	edge.parent = names.getName(block.parent);
+	edge.transform = dequantize(sample.values, translationResolution, rotationResolution);
+	edge.time = fromMicroseconds(sample.time);
+	edge.isStatic = false;
+}
+
+bool TransformHistory::frameExists(const string& frame) const {
+	boost::mutex::scoped_lock lock(mutex);
+	if (edges.count(frame) > 0 || statics.count(frame) > 0) {
+		return true;
+	}
+	// frames only known as parents
+	map<string, Blocks>::const_iterator e;
+	for (e = edges.begin(); e != edges.end(); ++e) {
+		if (!e->second.empty() && names.getName(e->second.back().parent) == frame) {
+			return true;
+		}
+	}
+	map<string, TransformChainResolver::Edge>::const_iterator s;
+	for (s = statics.begin(); s != statics.end(); ++s) {
+		if (s->second.parent == frame) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Transform TransformHistory::lookupTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) const {
+	return resolver.lookupTransform(target_frame, source_frame, time);
+}
+
+Transform TransformHistory::lookupTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame) const {
+	return resolver.lookupTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame);
+}
+
+bool TransformHistory::canTransform(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time, string* error_msg) const {
+	return resolver.canTransform(target_frame, source_frame, time, error_msg);
+}
+
+bool TransformHistory::canTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame,
+		string* error_msg) const {
+	return resolver.canTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame, error_msg);
+}
+
+unsigned long TransformHistory::getSampleCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return samples;
+}
+
+size_t TransformHistory::getMemoryUsage() const {
+	boost::mutex::scoped_lock lock(mutex);
+	size_t bytes = 0;
+	map<string, Blocks>::const_iterator e;
+	for (e = edges.begin(); e != edges.end(); ++e) {
+		Blocks::const_iterator b;
+		for (b = e->second.begin(); b != e->second.end(); ++b) {
+			bytes += sizeof(Block) + b->data.capacity();
+		}
+	}
+	return bytes;
+}
+
+void TransformHistory::printContents(std::ostream& stream) const {
+	size_t bytes = getMemoryUsage();
+	boost::mutex::scoped_lock lock(mutex);
+	stream << "historyTime = " << boost::posix_time::microseconds(historyTime);
+	stream << ", #edges = " << edges.size();
+	stream << ", #samples = " << samples;
+	stream << ", bytes = " << bytes;
+	stream << ", rejected = " << rejected;
+}
+
+}  // namespace rct
@@ -0,0 +1,129 @@
+/*
+ * TransformHistory.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformChainResolver.h"
+#include "NameDictionary.h"
+#include <rsc/runtime/Printable.h>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <deque>
+#include <map>
+
+namespace rct {
+
+/**
+ * Compressed long-term history of the transforms of a core.
+ *
+ * Samples are quantized and stored per edge in blocks of delta encoded
+ * varints. The first sample of every block is a keyframe holding absolute
+ * values, so a block is decompressed on its own when a lookup needs it.
+ * Blocks whose newest sample is older than the history time, counted back
+ * from the newest sample of any edge, are dropped.
+ *
+ * The history holds every sample, including the recent ones the core
+ * keeps uncompressed. The core only asks the history for times it does
+ * not cover any more. Samples older than the newest sample of their edge
+ * or older than the history time are not added.
+ */
+class TransformHistory: public TransformChainResolver::EdgeSource,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformHistory> Ptr;
+
+	/**
+	 * \param translationResolution quantization of translations in meters
+	 * \param rotationResolution quantization of quaternion components
+	 * \param blockSize number of samples per block
+	 */
+	TransformHistory(const boost::posix_time::time_duration& historyTime,
+			double translationResolution, double rotationResolution,
+			unsigned int blockSize = 256);
+	virtual ~TransformHistory();
+
+	void add(const Transform& transform, bool isStatic);
+	void add(const std::vector<Transform>& transforms, bool isStatic);
+	void clear();
+
+	/** \brief Same semantics and exceptions as TransformerCore::lookupTransform() */
+	Transform lookupTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time) const;
+	Transform lookupTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame) const;
+
+	bool canTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time, std::string* error_msg = NULL) const;
+	bool canTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame,
+			std::string* error_msg = NULL) const;
+
+	virtual bool getEdge(const std::string& frame, const boost::posix_time::ptime& time,
+			TransformChainResolver::Edge& edge) const;
+	virtual bool frameExists(const std::string& frame) const;
+
+	/** \brief Number of dynamic samples held */
+	unsigned long getSampleCount() const;
+
+	/** \brief Approximate number of bytes used by the blocks */
+	size_t getMemoryUsage() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	class Sample {
+	public:
+		// microseconds since epoch
+		boost::int64_t time;
+		boost::int64_t values[7];
+	};
+
+	class Block {
+	public:
+		boost::int64_t first;
+		boost::int64_t last;
+		boost::uint32_t parent;
+		boost::uint32_t count;
+		// quantized values of the last sample, the base of the next delta
+		boost::int64_t values[7];
+		std::string data;
+	};
+
+	typedef std::deque<Block> Blocks;
+
+	boost::int64_t historyTime;
+	double translationResolution;
+	double rotationResolution;
+	unsigned int blockSize;
+
+	mutable boost::mutex mutex;
+	NameDictionary names;
+	std::map<std::string, Blocks> edges;
+	std::map<std::string, TransformChainResolver::Edge> statics;
+	unsigned long samples;
+	unsigned long rejected;
+	// newest sample of all edges, all edges are expired when it passes nextExpiry
+	boost::int64_t newest;
+	boost::int64_t nextExpiry;
+
+	TransformChainResolver resolver;
+
+	void append(const Transform& transform, bool isStatic);
+	void expire(boost::int64_t time);
+	void expire(Blocks& blocks, boost::int64_t time);
+	void decode(const Block& block, std::vector<Sample>& out) const;
+	void toEdge(const Sample& sample, const Block& block, TransformChainResolver::Edge& edge) const;
+	static bool endsBefore(const Block& block, boost::int64_t time);
+	static bool after(boost::int64_t time, const Sample& sample);
+};
+
+}  // namespace rct
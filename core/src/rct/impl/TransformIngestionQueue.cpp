@@ -0,0 +1,217 @@
+/*
+ * TransformIngestionQueue.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformIngestionQueue.h"
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformIngestionQueue::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformIngestionQueue");
+
+static size_t checkedDepth(const TransformerConfig& config) {
+	// a full queue without room for one transform would never accept a push
+	if (config.getIngestionDepth() < 1) {
+		throw std::invalid_argument("Ingestion depth must be at least 1.");
+	}
+	return config.getIngestionDepth();
+}
+
+TransformIngestionQueue::TransformIngestionQueue(const vector<TransformListener::Ptr>& l,
+		const TransformerConfig& config) :
+		dynamicLane(checkedDepth(config)), staticPending(0), batchSize(
+				std::max<size_t>(1, config.getIngestionBatchSize())), staticBatchSize(
+				std::max<size_t>(1, config.getIngestionStaticBatchSize())), dropPolicy(
+				config.getIngestionDropPolicy()), idleWorkers(0), running(true), dropped(0), processed(
+				0) {
+
+	downstream.add(l);
+
+	unsigned int numWorkers = std::max(1u, config.getIngestionWorkers());
+	for (unsigned int i = 0; i < numWorkers; ++i) {
+		workers.create_thread(boost::bind(&TransformIngestionQueue::work, this));
+	}
+}
+
+TransformIngestionQueue::~TransformIngestionQueue() {
+	shutdown();
+}
+
+void TransformIngestionQueue::newTransformAvailable(const Transform& transform, bool isStatic) {
+	if (!running) {
+		return;
+	}
+
+	if (isStatic) {
+		pushStatic(transform);
+	} else {
+		push(new Transform(transform));
+	}
+
+	if (idleWorkers > 0) {
+		idleCondition.notify_one();
+	}
+}
+
+void TransformIngestionQueue::push(Transform* transform) {
+	// bounded_push only uses preallocated nodes and never blocks
+	while (!dynamicLane.bounded_push(transform)) {
+		if (dropPolicy == TransformerConfig::DROP_NEWEST) {
+			delete transform;
+			dropped++;
+			RSCTRACE(logger, "Ingestion queue full. Dropped newest transform.");
+			return;
+		}
+		Transform* oldest;
+		if (dynamicLane.pop(oldest)) {
+			delete oldest;
+			dropped++;
+			RSCTRACE(logger, "Ingestion queue full. Dropped oldest transform.");
+		}
+	}
+}
+
+void TransformIngestionQueue::pushStatic(const Transform& transform) {
+	boost::mutex::scoped_lock lock(staticMutex);
+	pair<map<string, Transform>::iterator, bool> inserted = staticLane.insert(
+			make_pair(transform.getFrameChild(), transform));
+	if (inserted.second) {
+		staticPending++;
+	} else {
+		// a newer static replaces one not applied yet
+		inserted.first->second = transform;
+	}
+}
+
+bool TransformIngestionQueue::applyStatics(vector<Transform>& transforms, size_t max) {
+	if (staticPending == 0) {
+		return false;
+	}
+	boost::mutex::scoped_try_lock drain(drainMutex);
+	if (!drain.owns_lock()) {
+		// another worker applies statics, overtaking it could reorder them
+		return false;
+	}
+	if (staticDrain.empty()) {
+		boost::mutex::scoped_lock lock(staticMutex);
+		staticDrain.swap(staticLane);
+	}
+	while (transforms.size() < max && !staticDrain.empty()) {
+		transforms.push_back(staticDrain.begin()->second);
+		staticDrain.erase(staticDrain.begin());
+	}
+	if (transforms.empty()) {
+		return false;
+	}
+	staticPending -= transforms.size();
+	deliver(transforms, true);
+	return true;
+}
+
+void TransformIngestionQueue::shutdown() {
+	if (!running.exchange(false)) {
+		return;
+	}
+	idleCondition.notify_all();
+	workers.join_all();
+
+	Transform* transform;
+	while (dynamicLane.pop(transform)) {
+		delete transform;
+	}
+	{
+		boost::mutex::scoped_lock drain(drainMutex);
+		boost::mutex::scoped_lock lock(staticMutex);
+		staticDrain.clear();
+		staticLane.clear();
+		staticPending = 0;
+	}
+	downstream.clear();
+}
+
+unsigned long TransformIngestionQueue::getDropped() const {
+	return dropped;
+}
+
+unsigned long TransformIngestionQueue::getProcessed() const {
+	return processed;
+}
+
+void TransformIngestionQueue::work() {
+	vector<Transform*> batch;
+	batch.reserve(batchSize);
+	vector<Transform> statics;
+	statics.reserve(staticBatchSize);
+
+	while (running) {
+		Transform* transform;
+
+		// live updates first
+		while (batch.size() < batchSize && dynamicLane.pop(transform)) {
+			batch.push_back(transform);
+		}
+		if (!batch.empty()) {
+			deliver(batch);
+			// guaranteed share for statics under sustained dynamic load
+			applyStatics(statics, batchSize);
+			continue;
+		}
+
+		// static backfill in large batches while no dynamic transform is waiting
+		if (applyStatics(statics, staticBatchSize)) {
+			continue;
+		}
+
+		// notifications are sent without holding the mutex, so a wakeup may be
+		// missed. The timeout bounds the latency in that case. Pending statics
+		// left here are being applied by another worker, which picks up the
+		// rest afterwards.
+		boost::mutex::scoped_lock lock(idleMutex);
+		idleWorkers++;
+		if (running && dynamicLane.empty()) {
+			idleCondition.timed_wait(lock, boost::posix_time::milliseconds(10));
+		}
+		idleWorkers--;
+	}
+}
+
+void TransformIngestionQueue::deliver(vector<Transform*>& batch) {
+	vector<Transform> transforms;
+	transforms.reserve(batch.size());
+
+	vector<Transform*>::iterator it;
+	for (it = batch.begin(); it != batch.end(); ++it) {
+		transforms.push_back(**it);
+		delete *it;
+	}
+	batch.clear();
+
+	deliver(transforms, false);
+}
+
+void TransformIngestionQueue::deliver(vector<Transform>& transforms, bool isStatic) {
+	try {
+		downstream.notify(transforms, isStatic);
+	} catch (std::exception &e) {
+		RSCERROR(logger, "Listener failed to apply transforms. Reason: " << e.what());
+	}
+	processed += transforms.size();
+	transforms.clear();
+}
+
+void TransformIngestionQueue::printContents(std::ostream& stream) const {
+	stream << "#listeners = " << downstream.size();
+	stream << ", batchSize = " << batchSize;
+	stream << ", staticBatchSize = " << staticBatchSize;
+	stream << ", dropPolicy = " << TransformerConfig::dropPolicyToString(dropPolicy);
+	stream << ", pendingStatics = " << staticPending;
+	stream << ", processed = " << processed;
+	stream << ", dropped = " << dropped;
+}
+
+}  // namespace rct
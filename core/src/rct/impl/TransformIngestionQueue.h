@@ -0,0 +1,102 @@
+/*
+ * TransformIngestionQueue.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformListener.h"
+#include "TransformListenerList.h"
+#include "../TransformerConfig.h"
+#include <rsc/runtime/Printable.h>
+#include <rsc/logging/Logger.h>
+#include <boost/noncopyable.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <map>
+
+namespace rct {
+
+/**
+ * Decouples the middleware callback threads from the transformer core.
+ *
+ * Incoming transforms are pushed into bounded lock-free queues and applied
+ * to the downstream listeners (usually the core) in batches by dedicated
+ * worker threads. Pushing never blocks: if a queue is full, either the
+ * incoming or the oldest queued transform is dropped, depending on the
+ * configured drop policy.
+ *
+ * Static and dynamic transforms use separate lanes. Static transforms are
+ * sent once or on sync only and are therefore never dropped: the static
+ * lane keeps the latest transform per child frame, so its size is bounded
+ * by the number of frames. Workers prefer the dynamic lane, so live updates
+ * are not delayed by bulk static backfill (e.g. after a sync request), but
+ * apply up to one dynamic batch size of static transforms after every
+ * dynamic batch, so statics are not starved under sustained load. Static
+ * transforms are applied in large batches whenever the dynamic lane is
+ * empty.
+ */
+class TransformIngestionQueue: public TransformListener,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformIngestionQueue> Ptr;
+
+	TransformIngestionQueue(const std::vector<TransformListener::Ptr>& downstream,
+			const TransformerConfig& config = TransformerConfig());
+	virtual ~TransformIngestionQueue();
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+
+	/** \brief Stops the workers. Transforms still queued are discarded. */
+	void shutdown();
+
+	/** \brief Number of transforms dropped because the queue was full */
+	unsigned long getDropped() const;
+
+	/** \brief Number of transforms handed to the downstream listeners */
+	unsigned long getProcessed() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	typedef boost::lockfree::queue<Transform*> Lane;
+
+	TransformListenerList downstream;
+	Lane dynamicLane;
+	// Latest pending static transform per child frame. The middleware thread
+	// only inserts into it, workers swap it with the drained map in constant
+	// time, so pushing never waits for a batch being copied.
+	boost::mutex staticMutex;
+	std::map<std::string, Transform> staticLane;
+	// statics taken from the lane, applied by one worker at a time to keep
+	// their order (guarded by drainMutex)
+	boost::mutex drainMutex;
+	std::map<std::string, Transform> staticDrain;
+	boost::atomic<size_t> staticPending;
+	size_t batchSize;
+	size_t staticBatchSize;
+	TransformerConfig::DropPolicy dropPolicy;
+
+	boost::thread_group workers;
+	boost::mutex idleMutex;
+	boost::condition_variable idleCondition;
+	boost::atomic<unsigned int> idleWorkers;
+	boost::atomic<bool> running;
+	boost::atomic<unsigned long> dropped;
+	boost::atomic<unsigned long> processed;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void push(Transform* transform);
+	void pushStatic(const Transform& transform);
+	bool applyStatics(std::vector<Transform>& transforms, size_t max);
+	void work();
+	void deliver(std::vector<Transform*>& batch);
+	void deliver(std::vector<Transform>& transforms, bool isStatic);
+};
+
+}  // namespace rct
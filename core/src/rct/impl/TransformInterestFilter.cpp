@@ -0,0 +1,186 @@
+/*
+ * TransformInterestFilter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformInterestFilter.h"
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformInterestFilter::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformInterestFilter");
+
+// guards the walks up the tree against cycles in inconsistent data
+static const unsigned int maxChainDepth = 1000;
+
+TransformInterestFilter::TransformInterestFilter(const vector<TransformListener::Ptr>& l,
+		const vector<string>& f, const vector<string>& s) :
+		frames(f.begin(), f.end()), subtrees(s.begin(), s.end()), dropped(0) {
+	downstream.add(l);
+	vector<Transform> released;
+	changed(released);
+}
+
+TransformInterestFilter::~TransformInterestFilter() {
+}
+
+void TransformInterestFilter::newTransformAvailable(const Transform& transform, bool isStatic) {
+	vector<Transform> released;
+	bool pass;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		pass = filter(transform, isStatic, released);
+	}
+	forward(released, true);
+	if (pass) {
+		downstream.notify(transform, isStatic);
+	}
+}
+
+void TransformInterestFilter::newTransformsAvailable(const vector<Transform>& transforms,
+		bool isStatic) {
+	vector<Transform> released;
+	vector<Transform> passed;
+	passed.reserve(transforms.size());
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			if (filter(*it, isStatic, released)) {
+				passed.push_back(*it);
+			}
+		}
+	}
+	forward(released, true);
+	forward(passed, isStatic);
+}
+
+void TransformInterestFilter::addFrame(const string& frame) {
+	vector<Transform> released;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (!frames.insert(frame).second) {
+			return;
+		}
+		RSCDEBUG(logger, "Interested in frame " << frame);
+		changed(released);
+	}
+	forward(released, true);
+}
+
+void TransformInterestFilter::addSubtree(const string& frame) {
+	vector<Transform> released;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (!subtrees.insert(frame).second) {
+			return;
+		}
+		RSCDEBUG(logger, "Interested in subtree " << frame);
+		changed(released);
+	}
+	forward(released, true);
+}
+
+unsigned long TransformInterestFilter::getDropped() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return dropped;
+}
+
+bool TransformInterestFilter::filter(const Transform& transform, bool isStatic,
+		vector<Transform>& released) {
+	const string& child = transform.getFrameChild();
+
+	map<string, string>::iterator it = parents.find(child);
+	if (it == parents.end() || it->second != transform.getFrameParent()) {
+		parents[child] = transform.getFrameParent();
+		changed(released);
+	}
+
+	if (isInteresting(child)) {
+		return true;
+	}
+	if (isStatic) {
+		held[child] = transform;
+	} else {
+		dropped++;
+	}
+	return false;
+}
+
+bool TransformInterestFilter::isInteresting(const string& child) {
+	map<string, bool>::const_iterator it = decisions.find(child);
+	if (it != decisions.end()) {
+		return it->second;
+	}
+
+	bool interesting = ancestors.count(child) > 0;
+	string frame = child;
+	for (unsigned int depth = 0; !interesting && depth < maxChainDepth; ++depth) {
+		if (subtrees.count(frame)) {
+			interesting = true;
+			break;
+		}
+		map<string, string>::const_iterator parent = parents.find(frame);
+		if (parent == parents.end()) {
+			break;
+		}
+		frame = parent->second;
+	}
+	decisions[child] = interesting;
+	return interesting;
+}
+
+void TransformInterestFilter::changed(vector<Transform>& released) {
+	decisions.clear();
+
+	ancestors.clear();
+	set<string> roots(frames);
+	roots.insert(subtrees.begin(), subtrees.end());
+	set<string>::const_iterator it;
+	for (it = roots.begin(); it != roots.end(); ++it) {
+		string frame = *it;
+		for (unsigned int depth = 0; depth < maxChainDepth; ++depth) {
+			if (!ancestors.insert(frame).second && frame != *it) {
+				// the rest of the chain is already known
+				break;
+			}
+			map<string, string>::const_iterator parent = parents.find(frame);
+			if (parent == parents.end()) {
+				break;
+			}
+			frame = parent->second;
+		}
+	}
+
+	map<string, Transform>::iterator heldIt = held.begin();
+	while (heldIt != held.end()) {
+		if (isInteresting(heldIt->first)) {
+			released.push_back(heldIt->second);
+			held.erase(heldIt++);
+			continue;
+		}
+		++heldIt;
+	}
+}
+
+void TransformInterestFilter::forward(const vector<Transform>& transforms, bool isStatic) {
+	if (transforms.empty()) {
+		return;
+	}
+	downstream.notify(transforms, isStatic);
+}
+
+void TransformInterestFilter::printContents(std::ostream& stream) const {
+	boost::mutex::scoped_lock lock(mutex);
+	stream << "#frames = " << frames.size();
+	stream << ", #subtrees = " << subtrees.size();
+	stream << ", #edges = " << parents.size();
+	stream << ", #held = " << held.size();
+	stream << ", dropped = " << dropped;
+}
+
+}  // namespace rct
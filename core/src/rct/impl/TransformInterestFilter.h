@@ -0,0 +1,81 @@
+/*
+ * TransformInterestFilter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformListener.h"
+#include "TransformListenerList.h"
+#include <rsc/runtime/Printable.h>
+#include <rsc/logging/Logger.h>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <set>
+#include <string>
+
+namespace rct {
+
+/**
+ * Forwards only the transforms a receiver needs to the downstream listeners
+ * (usually the core).
+ *
+ * Interest is expressed as frames and subtrees. For a frame, the edges of
+ * its chain up to the root are forwarded. For a subtree, additionally all
+ * edges below its root frame are forwarded. The filter learns the topology
+ * of the whole tree from every incoming transform, including the dropped
+ * ones, so decisions follow parent changes.
+ *
+ * Dropped dynamic transforms are discarded. The latest static transform of
+ * every dropped edge is held back and forwarded as soon as the edge becomes
+ * interesting, since static transforms are usually not sent again.
+ */
+class TransformInterestFilter: public TransformListener,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformInterestFilter> Ptr;
+
+	TransformInterestFilter(const std::vector<TransformListener::Ptr>& downstream,
+			const std::vector<std::string>& frames, const std::vector<std::string>& subtrees);
+	virtual ~TransformInterestFilter();
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic);
+
+	/** \brief Also forward the chain of the given frame. Used to learn from lookups. */
+	void addFrame(const std::string& frame);
+	void addSubtree(const std::string& frame);
+
+	/** \brief Number of dynamic transforms not forwarded */
+	unsigned long getDropped() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	TransformListenerList downstream;
+
+	mutable boost::mutex mutex;
+	std::set<std::string> frames;
+	std::set<std::string> subtrees;
+	// child -> parent of every edge seen so far
+	std::map<std::string, std::string> parents;
+	// frames on the chains of the frames and subtree roots of interest
+	std::set<std::string> ancestors;
+	// decisions per child frame, valid until the topology or interest changes
+	std::map<std::string, bool> decisions;
+	std::map<std::string, Transform> held;
+	unsigned long dropped;
+
+	static rsc::logging::LoggerPtr logger;
+
+	bool filter(const Transform& transform, bool isStatic, std::vector<Transform>& released);
+	bool isInteresting(const std::string& child);
+	void changed(std::vector<Transform>& released);
+	void forward(const std::vector<Transform>& transforms, bool isStatic);
+};
+
+}  // namespace rct
@@ -9,6 +9,7 @@
 
 #include <rct/Transform.h>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace rct {
 
@@ -22,6 +23,17 @@ public:
 
 	virtual void newTransformAvailable(const Transform& transform, bool isStatic) = 0;
 
+	/**
+	 * Delivers several transforms at once. Listeners that can apply a batch
+	 * more efficiently than one transform at a time should override this.
+	 */
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic) {
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			newTransformAvailable(*it, isStatic);
+		}
+	}
+
 };
 
 }  // namespace rct
@@ -0,0 +1,81 @@
+/*
+ * TransformListenerList.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformListenerList.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+TransformListenerList::TransformListenerList() :
+		listeners(new Listeners()) {
+}
+
+TransformListenerList::~TransformListenerList() {
+}
+
+void TransformListenerList::add(const TransformListener::Ptr& l) {
+	boost::mutex::scoped_lock lock(writeMutex);
+	boost::shared_ptr<Listeners> next(new Listeners(*snapshot()));
+	next->push_back(l);
+	replace(next);
+}
+
+void TransformListenerList::add(const vector<TransformListener::Ptr>& l) {
+	boost::mutex::scoped_lock lock(writeMutex);
+	boost::shared_ptr<Listeners> next(new Listeners(*snapshot()));
+	next->insert(next->end(), l.begin(), l.end());
+	replace(next);
+}
+
+void TransformListenerList::remove(const TransformListener::Ptr& l) {
+	boost::mutex::scoped_lock lock(writeMutex);
+	ListenersPtr current = snapshot();
+	Listeners::const_iterator it = find(current->begin(), current->end(), l);
+	if (it == current->end()) {
+		return;
+	}
+	boost::shared_ptr<Listeners> next(new Listeners(*current));
+	next->erase(next->begin() + (it - current->begin()));
+	replace(next);
+}
+
+void TransformListenerList::clear() {
+	boost::mutex::scoped_lock lock(writeMutex);
+	replace(ListenersPtr(new Listeners()));
+}
+
+TransformListenerList::ListenersPtr TransformListenerList::snapshot() const {
+	return boost::atomic_load(&listeners);
+}
+
+size_t TransformListenerList::size() const {
+	return snapshot()->size();
+}
+
+void TransformListenerList::notify(const Transform& transform, bool isStatic) const {
+	ListenersPtr current = snapshot();
+	Listeners::const_iterator it;
+	for (it = current->begin(); it != current->end(); ++it) {
+		(*it)->newTransformAvailable(transform, isStatic);
+	}
+}
+
+void TransformListenerList::notify(const vector<Transform>& transforms, bool isStatic) const {
+	ListenersPtr current = snapshot();
+	Listeners::const_iterator it;
+	for (it = current->begin(); it != current->end(); ++it) {
+		(*it)->newTransformsAvailable(transforms, isStatic);
+	}
+}
+
+void TransformListenerList::replace(const ListenersPtr& next) {
+	boost::atomic_store(&listeners, next);
+}
+
+}  // namespace rct
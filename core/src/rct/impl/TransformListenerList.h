@@ -0,0 +1,52 @@
+/*
+ * TransformListenerList.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformListener.h"
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+namespace rct {
+
+/**
+ * Copy-on-write list of transform listeners used by the communicators.
+ *
+ * Registration builds a new immutable list and swaps it in atomically, so
+ * dispatching from a middleware thread only takes a snapshot of the current
+ * list and never waits for (or races with) concurrent add/remove calls.
+ */
+class TransformListenerList {
+public:
+	typedef std::vector<TransformListener::Ptr> Listeners;
+	typedef boost::shared_ptr<const Listeners> ListenersPtr;
+
+	TransformListenerList();
+	virtual ~TransformListenerList();
+
+	void add(const TransformListener::Ptr& listener);
+	void add(const std::vector<TransformListener::Ptr>& listeners);
+	void remove(const TransformListener::Ptr& listener);
+	void clear();
+
+	/** \brief The current immutable listener list. Safe to iterate without locking. */
+	ListenersPtr snapshot() const;
+	size_t size() const;
+
+	/** \brief Notify every listener of the current snapshot */
+	void notify(const Transform& transform, bool isStatic) const;
+	void notify(const std::vector<Transform>& transforms, bool isStatic) const;
+
+private:
+	ListenersPtr listeners;
+	boost::mutex writeMutex;
+
+	void replace(const ListenersPtr& next);
+};
+
+}  // namespace rct
@@ -0,0 +1,364 @@
+/*
+ * TransformLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformLog.h"
+#include "TransformQuantizer.h"
+#include <boost/lexical_cast.hpp>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+const char TransformLog::magic[8] = { 'R', 'C', 'T', 'L', 'O', 'G', 0, 0 };
+const char TransformLog::indexMagic[8] = { 'R', 'C', 'T', 'I', 'D', 'X', 0, 0 };
+const boost::uint32_t TransformLog::version;
+const size_t TransformLog::headerSize;
+
+rsc::logging::LoggerPtr TransformLogReader::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformLogReader");
+
+void TransformLog::writeVarint(string& out, boost::uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back(char((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	out.push_back(char(value));
+}
+
+bool TransformLog::readVarint(const char*& position, const char* end, boost::uint64_t& value) {
+	value = 0;
+	for (unsigned int shift = 0; position < end && shift < 64; shift += 7) {
+		boost::uint8_t byte = boost::uint8_t(*position++);
+		value |= boost::uint64_t(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+string TransformLog::indexFile(const string& file) {
+	return file + ".idx";
+}
+
+static void writeHeader(ofstream& out, const char* magic) {
+	boost::uint32_t fields[2] = { TransformLog::version, 0 };
+	out.write(magic, 8);
+	out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+}
+
+static bool checkHeader(const char* data, size_t size, const char* magic) {
+	boost::uint32_t fileVersion;
+	if (size < TransformLog::headerSize || memcmp(data, magic, 8) != 0) {
+		return false;
+	}
+	memcpy(&fileVersion, data + 8, sizeof(fileVersion));
+	return fileVersion == TransformLog::version;
+}
+
+TransformLogWriter::TransformLogWriter(const string& file, unsigned int indexInterval,
+		const boost::posix_time::time_duration& flushInterval) :
+		out(file.c_str(), ios::binary | ios::trunc), index(TransformLog::indexFile(file).c_str(),
+				ios::binary | ios::trunc), indexInterval(std::max(1u, indexInterval)), offset(0), count(
+				0), sinceSync(this->indexInterval), lastTime(0), lastReceived(0), flushInterval(
+				flushInterval), lastFlush(boost::posix_time::microsec_clock::universal_time()) {
+	if (!out || !index) {
+		throw std::runtime_error("Cannot create transform log " + file);
+	}
+	writeHeader(out, TransformLog::magic);
+	writeHeader(index, TransformLog::indexMagic);
+	offset = TransformLog::headerSize;
+}
+
+TransformLogWriter::~TransformLogWriter() {
+	flush();
+}
+
+boost::uint32_t TransformLogWriter::name(const string& value) {
+	size_t known = names.size();
+	boost::uint32_t id = names.encode(value);
+	if (names.size() > known) {
+		buffer.push_back(char(TransformLog::ENTRY_NAME));
+		TransformLog::writeVarint(buffer, value.size());
+		buffer.append(value);
+	}
+	return id;
+}
+
+void TransformLogWriter::write(const Transform& transform, bool isStatic,
+		const boost::posix_time::ptime& received) {
+	buffer.clear();
+	boost::int64_t time = toMicroseconds(transform.getTime());
+	const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+	boost::int64_t receivedTime = toMicroseconds(received.is_special() ? now : received);
+
+	if (sinceSync >= indexInterval) {
+		TransformLog::IndexEntry entry;
+		entry.time = time;
+		entry.offset = offset;
+		entry.sample = count;
+		index.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+		buffer.push_back(char(TransformLog::ENTRY_SYNC));
+		names.clear();
+		lastTime = 0;
+		lastReceived = 0;
+		sinceSync = 0;
+		// a reader starting here knows neither names nor statics
+		map<string, Transform>::const_iterator it;
+		for (it = statics.begin(); it != statics.end(); ++it) {
+			append(it->second, TransformLog::SAMPLE_STATIC | TransformLog::SAMPLE_RESTATED,
+					receivedTime);
+		}
+	}
+
+	append(transform, isStatic ? TransformLog::SAMPLE_STATIC : 0, receivedTime);
+	if (isStatic) {
+		statics[transform.getFrameChild()] = transform;
+	}
+
+	out.write(buffer.data(), buffer.size());
+	offset += buffer.size();
+	count++;
+	sinceSync++;
+
+	// a crash loses at most the samples of one interval
+	if (now - lastFlush >= flushInterval) {
+		flush();
+	}
+}
+
+void TransformLogWriter::append(const Transform& transform, char flags,
+		boost::int64_t received) {
+	boost::int64_t time = toMicroseconds(transform.getTime());
+	boost::uint32_t parent = name(transform.getFrameParent());
+	boost::uint32_t child = name(transform.getFrameChild());
+	boost::uint32_t authority = name(transform.getAuthority());
+
+	Eigen::Vector3d t = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+	double values[7] = { t.x(), t.y(), t.z(), q.x(), q.y(), q.z(), q.w() };
+
+	buffer.push_back(char(TransformLog::ENTRY_SAMPLE));
+	buffer.push_back(flags);
+	TransformLog::writeVarint(buffer, parent);
+	TransformLog::writeVarint(buffer, child);
+	TransformLog::writeVarint(buffer, authority);
+	TransformLog::writeVarint(buffer, TransformLog::zigzag(time - lastTime));
+	TransformLog::writeVarint(buffer, TransformLog::zigzag(received - lastReceived));
+	buffer.append(reinterpret_cast<const char*>(values), sizeof(values));
+	lastTime = time;
+	lastReceived = received;
+}
+
+void TransformLogWriter::flush() {
+	out.flush();
+	index.flush();
+	lastFlush = boost::posix_time::microsec_clock::universal_time();
+}
+
+unsigned long TransformLogWriter::getCount() const {
+	return count;
+}
+
+TransformLogReader::TransformLogReader(const string& file) :
+		mapping(file.c_str(), boost::interprocess::read_only), region(mapping,
+				boost::interprocess::read_only), begin(static_cast<const char*>(region.get_address())), end(
+				begin + region.get_size()), position(begin), lastTime(0), lastReceived(0) {
+	if (!checkHeader(begin, region.get_size(), TransformLog::magic)) {
+		throw std::runtime_error(file + " is not a transform log of version "
+				+ boost::lexical_cast<string>(TransformLog::version));
+	}
+	rewind();
+	Transform first;
+	bool isStatic;
+	if (next(first, isStatic)) {
+		startTime = first.getTime();
+	}
+	rewind();
+	loadIndex(file);
+}
+
+TransformLogReader::~TransformLogReader() {
+}
+
+void TransformLogReader::loadIndex(const string& file) {
+	ifstream in(TransformLog::indexFile(file).c_str(), ios::binary);
+	char header[TransformLog::headerSize];
+	if (!in.read(header, sizeof(header))
+			|| !checkHeader(header, sizeof(header), TransformLog::indexMagic)) {
+		RSCWARN(logger, "No valid index for " << file << ", seeking reads the log from the beginning");
+		return;
+	}
+	TransformLog::IndexEntry entry;
+	size_t size = end - begin;
+	while (in.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
+		if (entry.offset >= size) {
+			// written before the log was cut off
+			break;
+		}
+		index.push_back(entry);
+	}
+}
+
+void TransformLogReader::rewind() {
+	position = begin + TransformLog::headerSize;
+	names.clear();
+	lastTime = 0;
+	lastReceived = 0;
+}
+
+bool TransformLogReader::next(Transform& transform, bool& isStatic) {
+	boost::posix_time::ptime received;
+	return next(transform, isStatic, received);
+}
+
+bool TransformLogReader::next(Transform& transform, bool& isStatic,
+		boost::posix_time::ptime& received) {
+	bool restated;
+	boost::int64_t receivedTime;
+	for (;;) {
+		int type = readEntry(transform, isStatic, restated, receivedTime);
+		if (type == 0) {
+			return false;
+		}
+		if (type == TransformLog::ENTRY_SAMPLE && !restated) {
+			received = fromMicroseconds(receivedTime);
+			return true;
+		}
+	}
+}
+
+int TransformLogReader::readEntry(Transform& transform, bool& isStatic, bool& restated,
+		boost::int64_t& received) {
+	if (position >= end) {
+		return 0;
+	}
+	const char* p = position;
+	char type = *p++;
+	boost::uint64_t length;
+
+	switch (type) {
+	case TransformLog::ENTRY_NAME:
+		if (!TransformLog::readVarint(p, end, length) || boost::uint64_t(end - p) < length) {
+			return 0;
+		}
+		names.define(names.size(), string(p, length));
+		position = p + length;
+		return type;
+
+	case TransformLog::ENTRY_SYNC:
+		names.clear();
+		lastTime = 0;
+		lastReceived = 0;
+		position = p;
+		return type;
+
+	case TransformLog::ENTRY_SAMPLE: {
+		boost::uint64_t ids[3];
+		boost::uint64_t delta;
+		boost::uint64_t receivedDelta;
+		double values[7];
+		if (p >= end) {
+			return 0;
+		}
+		char flags = *p++;
+		if (!TransformLog::readVarint(p, end, ids[0]) || !TransformLog::readVarint(p, end, ids[1])
+				|| !TransformLog::readVarint(p, end, ids[2])
+				|| !TransformLog::readVarint(p, end, delta)
+				|| !TransformLog::readVarint(p, end, receivedDelta)
+				|| size_t(end - p) < sizeof(values)) {
+			return 0;
+		}
+		memcpy(values, p, sizeof(values));
+		position = p + sizeof(values);
+
+		string parent, child, authority;
+		if (!names.decode(ids[0], parent) || !names.decode(ids[1], child)
+				|| !names.decode(ids[2], authority)) {
+			RSCERROR(logger, "Undefined name in log at offset " << (p - begin));
+			position = end;
+			return 0;
+		}
+		lastTime += TransformLog::unzigzag(delta);
+		lastReceived += TransformLog::unzigzag(receivedDelta);
+		received = lastReceived;
+
+		Eigen::Affine3d a = Eigen::Translation3d(values[0], values[1], values[2])
+				* Eigen::Quaterniond(values[6], values[3], values[4], values[5]);
+		transform = Transform(a, parent, child, fromMicroseconds(lastTime));
+		transform.setAuthority(authority);
+		isStatic = (flags & TransformLog::SAMPLE_STATIC) != 0;
+		restated = (flags & TransformLog::SAMPLE_RESTATED) != 0;
+		return type;
+	}
+
+	default:
+		RSCERROR(logger, "Corrupt log entry at offset " << (position - begin));
+		position = end;
+		return 0;
+	}
+}
+
+void TransformLogReader::seek(const boost::posix_time::ptime& time, vector<Transform>& statics) {
+	rewind();
+
+	boost::int64_t t = toMicroseconds(time);
+	vector<TransformLog::IndexEntry>::const_iterator it;
+	vector<TransformLog::IndexEntry>::const_iterator found = index.end();
+	for (it = index.begin(); it != index.end() && it->time <= t; ++it) {
+		found = it;
+	}
+	if (found != index.end()) {
+		// the SYNC entry restates names and statics
+		position = begin + found->offset;
+	}
+
+	// stop before the first sample not before the time
+	map<string, Transform> latest;
+	Transform transform;
+	bool isStatic;
+	bool restated;
+	boost::int64_t received;
+	for (;;) {
+		const char* entry = position;
+		boost::int64_t entryTime = lastTime;
+		boost::int64_t entryReceived = lastReceived;
+		int type = readEntry(transform, isStatic, restated, received);
+		if (type == 0) {
+			break;
+		}
+		if (type != TransformLog::ENTRY_SAMPLE) {
+			continue;
+		}
+		if (!restated && lastTime >= t) {
+			position = entry;
+			lastTime = entryTime;
+			lastReceived = entryReceived;
+			break;
+		}
+		if (isStatic) {
+			latest[transform.getFrameChild()] = transform;
+		}
+	}
+
+	map<string, Transform>::const_iterator staticIt;
+	for (staticIt = latest.begin(); staticIt != latest.end(); ++staticIt) {
+		statics.push_back(staticIt->second);
+	}
+}
+
+boost::posix_time::ptime TransformLogReader::getStartTime() const {
+	return startTime;
+}
+
+const vector<TransformLog::IndexEntry>& TransformLogReader::getIndex() const {
+	return index;
+}
+
+}  // namespace rct
@@ -0,0 +1,182 @@
+/*
+ * TransformLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "../Transform.h"
+#include "NameDictionary.h"
+#include <rsc/logging/Logger.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Binary log of transforms, e.g. for recording and replaying traffic.
+ *
+ * The log is a header followed by entries, each starting with its type:
+ * - NAME defines the next id of the frame and authority name dictionary
+ *   (varint length, characters).
+ * - SYNC resets the dictionary and the time base of the following samples.
+ *   It is followed by the latest static transform of every frame so far,
+ *   flagged as restated, so reading can start at any SYNC entry. The index
+ *   points to these entries.
+ * - SAMPLE holds a transform: flags, varint parent, child and authority
+ *   ids, zigzag varint time delta to the previous sample in microseconds,
+ *   zigzag varint delta of the time the sample was received, translation
+ *   and rotation (x, y, z, w) as raw doubles. Replay is paced by the
+ *   receive times, sensor time stamps may be out of order or delayed.
+ *
+ * Writing only appends and flushes at least every flush interval. A sidecar file (log name + ".idx") holds fixed
+ * size index entries with the time and offset of every SYNC entry. A log
+ * cut off by a crash ends at its last complete entry.
+ */
+class TransformLog {
+public:
+	static const char magic[8];
+	static const char indexMagic[8];
+	static const boost::uint32_t version = 3;
+	static const size_t headerSize = 16;
+
+	enum EntryType {
+		ENTRY_NAME = 1, ENTRY_SYNC = 2, ENTRY_SAMPLE = 3
+	};
+
+	enum SampleFlags {
+		SAMPLE_STATIC = 1,
+		// repeats a static transform after a SYNC entry
+		SAMPLE_RESTATED = 2
+	};
+
+	struct IndexEntry {
+		// time of the first sample after the SYNC entry, microseconds
+		boost::int64_t time;
+		// offset of the SYNC entry in the log
+		boost::uint64_t offset;
+		// number of samples before the SYNC entry
+		boost::uint64_t sample;
+	};
+
+	static void writeVarint(std::string& out, boost::uint64_t value);
+
+	/** \return false if the buffer ends within the varint */
+	static bool readVarint(const char*& position, const char* end, boost::uint64_t& value);
+
+	static boost::uint64_t zigzag(boost::int64_t value) {
+		return (boost::uint64_t(value) << 1) ^ boost::uint64_t(value >> 63);
+	}
+
+	static boost::int64_t unzigzag(boost::uint64_t value) {
+		return boost::int64_t(value >> 1) ^ -boost::int64_t(value & 1);
+	}
+
+	/** \brief Name of the index sidecar of a log */
+	static std::string indexFile(const std::string& file);
+};
+
+class TransformLogWriter: public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformLogWriter> Ptr;
+
+	/**
+	 * \param file log to create, an existing file is replaced
+	 * \param indexInterval maximum number of samples between index entries
+	 * \param flushInterval written samples reach the file at least this often
+	 */
+	TransformLogWriter(const std::string& file, unsigned int indexInterval = 1024,
+			const boost::posix_time::time_duration& flushInterval = boost::posix_time::seconds(1));
+	virtual ~TransformLogWriter();
+
+	/**
+	 * \param received time the transform was received, not a date time for
+	 *        now
+	 */
+	void write(const Transform& transform, bool isStatic,
+			const boost::posix_time::ptime& received = boost::posix_time::ptime());
+	void flush();
+
+	unsigned long getCount() const;
+
+private:
+	std::ofstream out;
+	std::ofstream index;
+	unsigned int indexInterval;
+	NameDictionary names;
+	std::string buffer;
+	boost::uint64_t offset;
+	boost::uint64_t count;
+	unsigned int sinceSync;
+	boost::int64_t lastTime;
+	boost::int64_t lastReceived;
+	boost::posix_time::time_duration flushInterval;
+	boost::posix_time::ptime lastFlush;
+	// latest static transform by child frame, restated after every SYNC
+	std::map<std::string, Transform> statics;
+
+	boost::uint32_t name(const std::string& value);
+	void append(const Transform& transform, char flags, boost::int64_t received);
+};
+
+class TransformLogReader: public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformLogReader> Ptr;
+
+	TransformLogReader(const std::string& file);
+	virtual ~TransformLogReader();
+
+	/** \return false at the end of the log */
+	bool next(Transform& transform, bool& isStatic);
+
+	/** \param received time the transform was received by the recorder */
+	bool next(Transform& transform, bool& isStatic, boost::posix_time::ptime& received);
+
+	/**
+	 * Continue reading at the first sample not before the given time. The
+	 * latest static transform of every frame before that position is added
+	 * to statics. Reading starts at the last index entry before the time,
+	 * without one the log is read from the beginning.
+	 */
+	void seek(const boost::posix_time::ptime& time, std::vector<Transform>& statics);
+
+	/** \brief Back to the first sample */
+	void rewind();
+
+	/** \brief Time of the first sample, not_a_date_time if the log is empty */
+	boost::posix_time::ptime getStartTime() const;
+
+	const std::vector<TransformLog::IndexEntry>& getIndex() const;
+
+private:
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const char* begin;
+	const char* end;
+	const char* position;
+	NameDictionary names;
+	boost::int64_t lastTime;
+	boost::int64_t lastReceived;
+	boost::posix_time::ptime startTime;
+	std::vector<TransformLog::IndexEntry> index;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void loadIndex(const std::string& file);
+
+	/** \brief Read the entry at the current position.
+	 * \return its type, 0 at the end of the log
+	 */
+	int readEntry(Transform& transform, bool& isStatic, bool& restated, boost::int64_t& received);
+};
+
+}  // namespace rct
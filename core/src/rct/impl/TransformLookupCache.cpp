@@ -0,0 +1,246 @@
+/*
+ * TransformLookupCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformLookupCache.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+static const unsigned int maxChainDepth = 1000;
+
+TransformLookupCache::TransformLookupCache(const TransformerCore::ConstPtr& core, size_t capacity,
+		const boost::posix_time::time_duration& cacheTime) :
+		core(core), capacity(std::max<size_t>(1, capacity)), cacheTime(cacheTime), generation(0) {
+}
+
+TransformLookupCache::~TransformLookupCache() {
+}
+
+Transform TransformLookupCache::lookupTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) {
+
+	const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	if (time.is_special() || time <= epoch) {
+		// "latest" changes with every incoming transform
+		return core->lookupTransform(target_frame, source_frame, time);
+	}
+
+	Key key(target_frame, source_frame, time);
+	unsigned long startGeneration;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		map<Key, EntryList::iterator>::iterator it = index.find(key);
+		if (it != index.end()) {
+			entries.splice(entries.begin(), entries, it->second);
+			statistics.hits++;
+			return it->second->transform;
+		}
+		statistics.misses++;
+		startGeneration = generation;
+	}
+
+	Transform result = core->lookupTransform(target_frame, source_frame, time);
+	vector<string> edges = chainEdges(target_frame, source_frame, time);
+
+	boost::mutex::scoped_lock lock(mutex);
+	if (generation != startGeneration || index.count(key) || isExpired(edges, time)) {
+		// data changed while looking up, the result may already be outdated
+		return result;
+	}
+	entries.push_front(Entry(key, result, edges));
+	index[key] = entries.begin();
+	vector<string>::const_iterator edgeIt;
+	for (edgeIt = edges.begin(); edgeIt != edges.end(); ++edgeIt) {
+		entriesByEdge[*edgeIt].insert(key);
+	}
+	while (entries.size() > capacity) {
+		erase(index.find(entries.back().key));
+		statistics.evictions++;
+	}
+	return result;
+}
+
+void TransformLookupCache::newTransformAvailable(const Transform& transform, bool isStatic) {
+	Eigen::Matrix<double, 3, 4, Eigen::DontAlign> value = transform.getTransform().matrix().topRows<3>();
+
+	boost::mutex::scoped_lock lock(mutex);
+	map<string, EdgeState>::iterator it = edgeStates.find(transform.getFrameChild());
+	if (it == edgeStates.end()) {
+		// a new edge cannot change a chain that was already resolvable
+		EdgeState state;
+		state.parent = transform.getFrameParent();
+		state.isStatic = isStatic;
+		state.latest = transform.getTime();
+		state.latestValue = value;
+		edgeStates[transform.getFrameChild()] = state;
+		return;
+	}
+
+	EdgeState& state = it->second;
+	bool changed = state.parent != transform.getFrameParent();
+	if (isStatic) {
+		changed = changed || state.latestValue != value;
+	} else if (transform.getTime() < state.latest) {
+		changed = true;
+	} else if (transform.getTime() == state.latest) {
+		changed = changed || state.latestValue != value;
+	}
+
+	if (changed) {
+		invalidateEdge(transform.getFrameChild());
+	}
+	state.parent = transform.getFrameParent();
+	state.isStatic = isStatic;
+	if (isStatic || transform.getTime() >= state.latest) {
+		state.latest = transform.getTime();
+		state.latestValue = value;
+	}
+	if (!isStatic) {
+		// the core drops samples older than the cache time behind the newest one
+		expireEdge(transform.getFrameChild(), state.latest - cacheTime);
+	}
+}
+
+void TransformLookupCache::clear() {
+	boost::mutex::scoped_lock lock(mutex);
+	generation++;
+	entries.clear();
+	index.clear();
+	entriesByEdge.clear();
+}
+
+TransformLookupCache::Statistics TransformLookupCache::getStatistics() const {
+	boost::mutex::scoped_lock lock(mutex);
+	Statistics result = statistics;
+	result.size = entries.size();
+	return result;
+}
+
+vector<string> TransformLookupCache::chainEdges(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) const {
+
+	vector<string> targetChain = ancestors(target_frame, time);
+	vector<string> sourceChain = ancestors(source_frame, time);
+
+	// edges are identified by their child frame; only edges below the common
+	// ancestor contribute to the result
+	vector<string> edges;
+	vector<string>::const_iterator common = sourceChain.end();
+	vector<string>::const_iterator it;
+	for (it = sourceChain.begin(); it != sourceChain.end(); ++it) {
+		common = find(targetChain.begin(), targetChain.end(), *it);
+		if (common != targetChain.end()) {
+			break;
+		}
+		edges.push_back(*it);
+	}
+	for (it = targetChain.begin(); it != targetChain.end(); ++it) {
+		if (it == common) {
+			break;
+		}
+		edges.push_back(*it);
+	}
+	return edges;
+}
+
+vector<string> TransformLookupCache::ancestors(const string& frame,
+		const boost::posix_time::ptime& time) const {
+	vector<string> chain;
+	chain.push_back(frame);
+	for (unsigned int i = 0; i < maxChainDepth; ++i) {
+		string parent = core->getParent(chain.back(), time);
+		if (parent.empty() || find(chain.begin(), chain.end(), parent) != chain.end()) {
+			break;
+		}
+		chain.push_back(parent);
+	}
+	return chain;
+}
+
+void TransformLookupCache::invalidateEdge(const string& child) {
+	generation++;
+	map<string, set<Key> >::iterator edgeIt = entriesByEdge.find(child);
+	if (edgeIt == entriesByEdge.end()) {
+		return;
+	}
+	set<Key> keys;
+	keys.swap(edgeIt->second);
+	set<Key>::const_iterator it;
+	for (it = keys.begin(); it != keys.end(); ++it) {
+		map<Key, EntryList::iterator>::iterator indexIt = index.find(*it);
+		if (indexIt != index.end()) {
+			erase(indexIt);
+			statistics.invalidations++;
+		}
+	}
+	entriesByEdge.erase(child);
+}
+
+void TransformLookupCache::expireEdge(const string& child, const boost::posix_time::ptime& horizon) {
+	map<string, set<Key> >::iterator edgeIt = entriesByEdge.find(child);
+	if (edgeIt == entriesByEdge.end()) {
+		return;
+	}
+	// keys are ordered by time, the expired ones come first
+	vector<Key> expired;
+	set<Key>::const_iterator it;
+	for (it = edgeIt->second.begin(); it != edgeIt->second.end() && it->time < horizon; ++it) {
+		expired.push_back(*it);
+	}
+	vector<Key>::const_iterator keyIt;
+	for (keyIt = expired.begin(); keyIt != expired.end(); ++keyIt) {
+		map<Key, EntryList::iterator>::iterator indexIt = index.find(*keyIt);
+		if (indexIt != index.end()) {
+			erase(indexIt);
+			statistics.expirations++;
+		}
+	}
+}
+
+bool TransformLookupCache::isExpired(const vector<string>& edges,
+		const boost::posix_time::ptime& time) const {
+	vector<string>::const_iterator it;
+	for (it = edges.begin(); it != edges.end(); ++it) {
+		map<string, EdgeState>::const_iterator stateIt = edgeStates.find(*it);
+		if (stateIt != edgeStates.end() && !stateIt->second.isStatic
+				&& time < stateIt->second.latest - cacheTime) {
+			// computed from history or outdated data the core no longer buffers
+			return true;
+		}
+	}
+	return false;
+}
+
+void TransformLookupCache::erase(map<Key, EntryList::iterator>::iterator it) {
+	const Entry& entry = *it->second;
+	vector<string>::const_iterator edgeIt;
+	for (edgeIt = entry.edges.begin(); edgeIt != entry.edges.end(); ++edgeIt) {
+		map<string, set<Key> >::iterator keysIt = entriesByEdge.find(*edgeIt);
+		if (keysIt != entriesByEdge.end()) {
+			keysIt->second.erase(entry.key);
+			if (keysIt->second.empty()) {
+				entriesByEdge.erase(keysIt);
+			}
+		}
+	}
+	entries.erase(it->second);
+	index.erase(it);
+}
+
+void TransformLookupCache::printContents(std::ostream& stream) const {
+	Statistics s = getStatistics();
+	stream << "capacity = " << capacity;
+	stream << ", size = " << s.size;
+	stream << ", hits = " << s.hits;
+	stream << ", misses = " << s.misses;
+	stream << ", invalidations = " << s.invalidations;
+	stream << ", expirations = " << s.expirations;
+}
+
+}  // namespace rct
@@ -0,0 +1,143 @@
+/*
+ * TransformLookupCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformerCore.h"
+#include "TransformListener.h"
+#include <rsc/runtime/Printable.h>
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <list>
+#include <map>
+#include <set>
+
+namespace rct {
+
+/**
+ * Bounded LRU cache for results of TransformerCore::lookupTransform().
+ *
+ * Results are keyed by target frame, source frame and exact time. For every
+ * cached result the edges (identified by their child frame) of the chain
+ * between both frames are remembered. The cache listens to incoming
+ * transforms and drops exactly those results whose chain contains an edge
+ * that received data which may change the result: a new parent, a changed
+ * static value or a sample not newer than the newest known one. Samples
+ * arriving in order cannot change a result that was already computable and
+ * therefore keep the cache intact.
+ *
+ * Lookups of the latest transform (time 0) are never cached. Results older
+ * than the cache time behind the newest sample of one of their dynamic edges
+ * are dropped, as the core has expired the data they were computed from.
+ *
+ * The cache must be notified after the core has applied a transform.
+ */
+class TransformLookupCache: public TransformListener,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformLookupCache> Ptr;
+
+	class Statistics {
+	public:
+		Statistics() :
+				hits(0), misses(0), invalidations(0), evictions(0), expirations(0), size(0) {
+		}
+		unsigned long hits;
+		unsigned long misses;
+		unsigned long invalidations;
+		unsigned long evictions;
+		unsigned long expirations;
+		size_t size;
+
+		double getHitRate() const {
+			unsigned long total = hits + misses;
+			return total == 0 ? 0.0 : double(hits) / double(total);
+		}
+	};
+
+	TransformLookupCache(const TransformerCore::ConstPtr& core, size_t capacity,
+			const boost::posix_time::time_duration& cacheTime);
+	virtual ~TransformLookupCache();
+
+	/** \brief Get the transform between two frames, from the cache if possible.
+	 * Same semantics and exceptions as TransformerCore::lookupTransform().
+	 */
+	Transform lookupTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time);
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+
+	void clear();
+	Statistics getStatistics() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	class Key {
+	public:
+		Key(const std::string& target, const std::string& source,
+				const boost::posix_time::ptime& time) :
+				target(target), source(source), time(time) {
+		}
+		std::string target;
+		std::string source;
+		boost::posix_time::ptime time;
+		bool operator<(const Key& k) const {
+			if (time != k.time) {
+				return time < k.time;
+			}
+			if (target != k.target) {
+				return target < k.target;
+			}
+			return source < k.source;
+		}
+	};
+
+	class Entry {
+	public:
+		Entry(const Key& key, const Transform& transform, const std::vector<std::string>& edges) :
+				key(key), transform(transform), edges(edges) {
+		}
+		Key key;
+		Transform transform;
+		std::vector<std::string> edges;
+	};
+
+	class EdgeState {
+	public:
+		std::string parent;
+		bool isStatic;
+		boost::posix_time::ptime latest;
+		Eigen::Matrix<double, 3, 4, Eigen::DontAlign> latestValue;
+	};
+
+	typedef std::list<Entry> EntryList;
+
+	TransformerCore::ConstPtr core;
+	size_t capacity;
+	boost::posix_time::time_duration cacheTime;
+
+	mutable boost::mutex mutex;
+	EntryList entries;
+	std::map<Key, EntryList::iterator> index;
+	std::map<std::string, std::set<Key> > entriesByEdge;
+	std::map<std::string, EdgeState> edgeStates;
+	unsigned long generation;
+	Statistics statistics;
+
+	std::vector<std::string> chainEdges(const std::string& target_frame,
+			const std::string& source_frame, const boost::posix_time::ptime& time) const;
+	std::vector<std::string> ancestors(const std::string& frame,
+			const boost::posix_time::ptime& time) const;
+	void invalidateEdge(const std::string& child);
+	void expireEdge(const std::string& child, const boost::posix_time::ptime& horizon);
+	bool isExpired(const std::vector<std::string>& edges, const boost::posix_time::ptime& time) const;
+	void erase(std::map<Key, EntryList::iterator>::iterator it);
+};
+
+}  // namespace rct
@@ -0,0 +1,441 @@
+/*
+ * TransformOfflineIndex.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformOfflineIndex.h"
+#include "TransformLog.h"
+#include "TransformQuantizer.h"
+#include "TransformRecord.h"
+#include <tf2/exceptions.h>
+#include <boost/filesystem.hpp>
+#include <boost/integer_traits.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace std;
+using namespace boost::interprocess;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformOfflineIndex::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformOfflineIndex");
+
+static const char magic[8] = { 'R', 'C', 'T', 'O', 'F', 'F', '\0', '\0' };
+static const boost::uint32_t formatVersion = 1;
+
+struct TransformOfflineIndex::Header {
+	char magic[8];
+	boost::uint32_t version;
+	boost::uint32_t sampleSize;
+	boost::uint32_t blockSize;
+	boost::uint32_t frameCount;
+	boost::uint64_t blockCount;
+	boost::uint64_t sampleCount;
+	// time range of the dynamic samples in microseconds, start > end if none
+	boost::int64_t startTime;
+	boost::int64_t endTime;
+};
+
+struct TransformOfflineIndex::Frame {
+	char name[TransformRecord::nameSize];
+	boost::uint32_t isStatic;
+	boost::uint32_t blockCount;
+	boost::uint64_t firstBlock;
+	boost::uint64_t firstSample;
+	// 0 for frames that are never a child
+	boost::uint64_t sampleCount;
+};
+
+struct TransformOfflineIndex::Block {
+	// microseconds
+	boost::int64_t first;
+	boost::int64_t last;
+	boost::uint64_t sample;
+	boost::uint64_t count;
+};
+
+struct TransformOfflineIndex::Sample {
+	boost::uint32_t parent;
+	boost::uint32_t reserved;
+	// microseconds since epoch
+	boost::int64_t time;
+	double translation[3];
+	// x, y, z, w
+	double rotation[4];
+};
+
+namespace {
+
+typedef TransformOfflineIndex::Sample Sample;
+
+/**
+ * Frames and number of samples per edge collected in the first pass over
+ * the log.
+ */
+class FrameTable {
+public:
+	map<string, boost::uint32_t> ids;
+	vector<string> names;
+	vector<boost::uint64_t> dynamicCounts;
+	vector<Sample> statics;
+	vector<bool> hasStatic;
+
+	boost::uint32_t id(const string& name) {
+		map<string, boost::uint32_t>::const_iterator it = ids.find(name);
+		if (it != ids.end()) {
+			return it->second;
+		}
+		if (name.size() >= TransformRecord::nameSize) {
+			throw std::invalid_argument("Frame name too long for the offline index: " + name);
+		}
+		boost::uint32_t next = names.size();
+		ids[name] = next;
+		names.push_back(name);
+		dynamicCounts.push_back(0);
+		statics.push_back(Sample());
+		hasStatic.push_back(false);
+		return next;
+	}
+};
+
+void toSample(const Transform& transform, boost::uint32_t parent, Sample& sample) {
+	Eigen::Vector3d translation = transform.getTranslation();
+	Eigen::Quaterniond rotation = transform.getRotationQuat();
+	sample.parent = parent;
+	sample.reserved = 0;
+	sample.time = toMicroseconds(transform.getTime());
+	for (int i = 0; i < 3; ++i) {
+		sample.translation[i] = translation[i];
+	}
+	sample.rotation[0] = rotation.x();
+	sample.rotation[1] = rotation.y();
+	sample.rotation[2] = rotation.z();
+	sample.rotation[3] = rotation.w();
+}
+
+bool earlier(const Sample& a, const Sample& b) {
+	return a.time < b.time;
+}
+
+bool blockEndsBefore(const TransformOfflineIndex::Block& block, boost::int64_t time) {
+	return block.last < time;
+}
+
+bool sampleAfter(boost::int64_t time, const Sample& sample) {
+	return time < sample.time;
+}
+
+string formatTime(boost::int64_t time) {
+	return boost::lexical_cast<string>(double(time) / 1e6);
+}
+
+}  // namespace
+
+TransformOfflineIndex::TransformOfflineIndex(const string& file) :
+		file(file), mapping(file.c_str(), read_only), region(mapping, read_only) {
+	// lookups jump through the file, read-ahead only wastes memory
+	region.advise(mapped_region::advice_random);
+
+	const char* data = static_cast<const char*>(region.get_address());
+	size_t size = region.get_size();
+	if (size < sizeof(Header)) {
+		throw std::runtime_error("Truncated offline index " + file);
+	}
+	header = reinterpret_cast<const Header*>(data);
+	if (memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != formatVersion
+			|| header->sampleSize != sizeof(Sample)) {
+		throw std::runtime_error("Offline index " + file + " has an unknown format");
+	}
+	size_t expected = sizeof(Header) + header->frameCount * sizeof(Frame)
+			+ header->blockCount * sizeof(Block) + header->sampleCount * sizeof(Sample);
+	if (size != expected) {
+		throw std::runtime_error("Offline index " + file + " has an invalid size");
+	}
+
+	frames = reinterpret_cast<const Frame*>(data + sizeof(Header));
+	blocks = reinterpret_cast<const Block*>(frames + header->frameCount);
+	samples = reinterpret_cast<const Sample*>(blocks + header->blockCount);
+
+	for (boost::uint32_t i = 0; i < header->frameCount; ++i) {
+		ids[frames[i].name] = i;
+	}
+	RSCDEBUG(logger,
+			"Opened " << file << " with " << header->frameCount << " frames and " << header->sampleCount << " samples");
+}
+
+TransformOfflineIndex::~TransformOfflineIndex() {
+}
+
+string TransformOfflineIndex::indexFile(const string& log) {
+	return log + ".edges";
+}
+
+void TransformOfflineIndex::build(const string& log, const string& file,
+		boost::uint32_t blockSize) {
+	blockSize = std::max<boost::uint32_t>(1, blockSize);
+	TransformLogReader reader(log);
+
+	// first pass: frames and number of samples per edge
+	FrameTable table;
+	boost::int64_t start = boost::integer_traits<boost::int64_t>::const_max;
+	boost::int64_t end = boost::integer_traits<boost::int64_t>::const_min;
+	Transform transform;
+	bool isStatic;
+	while (reader.next(transform, isStatic)) {
+		boost::uint32_t child = table.id(transform.getFrameChild());
+		boost::uint32_t parent = table.id(transform.getFrameParent());
+		if (isStatic) {
+			toSample(transform, parent, table.statics[child]);
+			table.hasStatic[child] = true;
+		} else {
+			table.dynamicCounts[child]++;
+			boost::int64_t time = toMicroseconds(transform.getTime());
+			start = std::min(start, time);
+			end = std::max(end, time);
+		}
+	}
+
+	// layout: header, frames, blocks, samples
+	boost::uint32_t frameCount = table.names.size();
+	vector<Frame> frameTable(frameCount);
+	boost::uint64_t blockCount = 0;
+	boost::uint64_t sampleCount = 0;
+	for (boost::uint32_t i = 0; i < frameCount; ++i) {
+		Frame& frame = frameTable[i];
+		memset(&frame, 0, sizeof(Frame));
+		strncpy(frame.name, table.names[i].c_str(), sizeof(frame.name) - 1);
+		if (table.dynamicCounts[i] > 0) {
+			if (table.hasStatic[i]) {
+				RSCWARN(logger,
+						"Frame " << table.names[i] << " has static and dynamic transforms. Indexing the dynamic ones.");
+			}
+			frame.sampleCount = table.dynamicCounts[i];
+		} else if (table.hasStatic[i]) {
+			frame.isStatic = 1;
+			frame.sampleCount = 1;
+		}
+		frame.firstSample = sampleCount;
+		frame.firstBlock = blockCount;
+		frame.blockCount = (frame.sampleCount + blockSize - 1) / blockSize;
+		sampleCount += frame.sampleCount;
+		blockCount += frame.blockCount;
+	}
+	size_t size = sizeof(Header) + frameCount * sizeof(Frame) + blockCount * sizeof(Block)
+			+ sampleCount * sizeof(Sample);
+
+	stringstream tmp;
+	tmp << file << ".tmp." << getpid();
+	{
+		filebuf fbuf;
+		if (!fbuf.open(tmp.str().c_str(), ios_base::in | ios_base::out | ios_base::trunc
+				| ios_base::binary)) {
+			throw std::runtime_error("Can not create offline index " + tmp.str());
+		}
+		fbuf.pubseekoff(size - 1, ios_base::beg);
+		fbuf.sputc(0);
+	}
+
+	{
+		file_mapping target(tmp.str().c_str(), read_write);
+		mapped_region out(target, read_write);
+		char* data = static_cast<char*>(out.get_address());
+
+		Header* h = reinterpret_cast<Header*>(data);
+		memset(h, 0, sizeof(Header));
+		memcpy(h->magic, magic, sizeof(magic));
+		h->version = formatVersion;
+		h->sampleSize = sizeof(Sample);
+		h->blockSize = blockSize;
+		h->frameCount = frameCount;
+		h->blockCount = blockCount;
+		h->sampleCount = sampleCount;
+		h->startTime = start;
+		h->endTime = end;
+
+		Frame* f = reinterpret_cast<Frame*>(data + sizeof(Header));
+		Block* b = reinterpret_cast<Block*>(f + frameCount);
+		Sample* s = reinterpret_cast<Sample*>(b + blockCount);
+		if (frameCount > 0) {
+			memcpy(f, &frameTable[0], frameCount * sizeof(Frame));
+		}
+
+		// second pass: samples, each edge in its own range
+		vector<boost::uint64_t> cursors(frameCount);
+		for (boost::uint32_t i = 0; i < frameCount; ++i) {
+			cursors[i] = f[i].firstSample;
+			if (f[i].isStatic) {
+				s[f[i].firstSample] = table.statics[i];
+			}
+		}
+		reader.rewind();
+		while (reader.next(transform, isStatic)) {
+			if (isStatic) {
+				continue;
+			}
+			boost::uint32_t child = table.ids[transform.getFrameChild()];
+			toSample(transform, table.ids[transform.getFrameParent()], s[cursors[child]++]);
+		}
+
+		for (boost::uint32_t i = 0; i < frameCount; ++i) {
+			if (f[i].isStatic || f[i].sampleCount == 0) {
+				continue;
+			}
+			// recordings are mostly in order already
+			Sample* first = s + f[i].firstSample;
+			std::stable_sort(first, first + f[i].sampleCount, earlier);
+
+			for (boost::uint32_t j = 0; j < f[i].blockCount; ++j) {
+				Block& block = b[f[i].firstBlock + j];
+				block.sample = f[i].firstSample + boost::uint64_t(j) * blockSize;
+				block.count = std::min<boost::uint64_t>(blockSize,
+						f[i].firstSample + f[i].sampleCount - block.sample);
+				block.first = s[block.sample].time;
+				block.last = s[block.sample + block.count - 1].time;
+			}
+		}
+		out.flush();
+	}
+
+	boost::system::error_code error;
+	boost::filesystem::rename(tmp.str(), file, error);
+	if (error) {
+		boost::filesystem::remove(tmp.str(), error);
+		throw std::runtime_error("Can not write offline index " + file);
+	}
+	RSCINFO(logger,
+			"Indexed " << sampleCount << " samples of " << frameCount << " frames from " << log << " in " << file);
+}
+
+const TransformOfflineIndex::Sample& TransformOfflineIndex::find(const Frame& frame,
+		boost::int64_t time, const Sample*& next) const {
+	const Block* first = blocks + frame.firstBlock;
+	const Block* last = first + frame.blockCount;
+
+	if (time > (last - 1)->last) {
+		throw tf2::ExtrapolationException(
+				"Lookup would require extrapolation into the future.  Requested time "
+						+ formatTime(time) + " but the latest data is at time "
+						+ formatTime((last - 1)->last)
+						+ ", when looking up transform from frame [" + frame.name + "]");
+	}
+	if (time < first->first) {
+		throw tf2::ExtrapolationException(
+				"Lookup would require extrapolation into the past.  Requested time "
+						+ formatTime(time) + " but the earliest data is at time "
+						+ formatTime(first->first) + ", when looking up transform from frame ["
+						+ frame.name + "]");
+	}
+
+	// only the block covering the time is touched
+	const Block* block = std::lower_bound(first, last, time, blockEndsBefore);
+	const Sample* begin = samples + block->sample;
+	const Sample* after = std::upper_bound(begin, begin + block->count, time, sampleAfter);
+
+	// samples of an edge are contiguous, the predecessor may end the previous block
+	const Sample* low = after - 1;
+	const Sample* end = samples + frame.firstSample + frame.sampleCount;
+	next = (low->time == time || after == end) ? NULL : after;
+	return *low;
+}
+
+bool TransformOfflineIndex::getEdge(const string& frame, const boost::posix_time::ptime& time,
+		TransformChainResolver::Edge& edge) const {
+	map<string, boost::uint32_t>::const_iterator id = ids.find(frame);
+	if (id == ids.end()) {
+		return false;
+	}
+	const Frame& f = frames[id->second];
+	if (f.sampleCount == 0) {
+		return false;
+	}
+	if (f.isStatic || TransformChainResolver::isLatest(time)) {
+		toEdge(samples[f.firstSample + f.sampleCount - 1], f.isStatic != 0, edge);
+		return true;
+	}
+
+	boost::int64_t t = toMicroseconds(time);
+	const Sample* high;
+	const Sample& low = find(f, t, high);
+	if (high == NULL) {
+		toEdge(low, false, edge);
+		return true;
+	}
+
+	double ratio = double(t - low.time) / double(high->time - low.time);
+	Sample sample = ratio < 0.5 ? low : *high;
+	sample.time = t;
+	for (int i = 0; i < 3; ++i) {
+		sample.translation[i] = low.translation[i]
+				+ ratio * (high->translation[i] - low.translation[i]);
+	}
+	Eigen::Quaterniond q0(low.rotation[3], low.rotation[0], low.rotation[1], low.rotation[2]);
+	Eigen::Quaterniond q1(high->rotation[3], high->rotation[0], high->rotation[1],
+			high->rotation[2]);
+	Eigen::Quaterniond q = q0.slerp(ratio, q1);
+	sample.rotation[0] = q.x();
+	sample.rotation[1] = q.y();
+	sample.rotation[2] = q.z();
+	sample.rotation[3] = q.w();
+	toEdge(sample, false, edge);
+	return true;
+}
+
+void TransformOfflineIndex::toEdge(const Sample& sample, bool isStatic,
+		TransformChainResolver::Edge& edge) const {
+	edge.parent = frames[sample.parent].name;
+	edge.transform = Eigen::Translation3d(sample.translation[0], sample.translation[1],
+			sample.translation[2])
+			* Eigen::Quaterniond(sample.rotation[3], sample.rotation[0], sample.rotation[1],
+					sample.rotation[2]);
+	edge.time = fromMicroseconds(sample.time);
+	edge.isStatic = isStatic;
+}
+
+bool TransformOfflineIndex::frameExists(const string& frame) const {
+	return ids.find(frame) != ids.end();
+}
+
+vector<string> TransformOfflineIndex::getFrameNames() const {
+	vector<string> names;
+	names.reserve(header->frameCount);
+	for (boost::uint32_t i = 0; i < header->frameCount; ++i) {
+		names.push_back(frames[i].name);
+	}
+	return names;
+}
+
+boost::posix_time::ptime TransformOfflineIndex::getStartTime() const {
+	if (header->startTime > header->endTime) {
+		return boost::posix_time::ptime();
+	}
+	return fromMicroseconds(header->startTime);
+}
+
+boost::posix_time::ptime TransformOfflineIndex::getEndTime() const {
+	if (header->startTime > header->endTime) {
+		return boost::posix_time::ptime();
+	}
+	return fromMicroseconds(header->endTime);
+}
+
+boost::uint64_t TransformOfflineIndex::getSampleCount() const {
+	return header->sampleCount;
+}
+
+boost::uint64_t TransformOfflineIndex::getBlockCount() const {
+	return header->blockCount;
+}
+
+boost::uint32_t TransformOfflineIndex::getBlockSize() const {
+	return header->blockSize;
+}
+
+}  // namespace rct
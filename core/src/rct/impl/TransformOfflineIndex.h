@@ -0,0 +1,90 @@
+/*
+ * TransformOfflineIndex.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformChainResolver.h"
+#include <rsc/logging/Logger.h>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Read-only, time-indexed copy of a TransformLog for offline lookups.
+ *
+ * The index file holds the samples of every edge (identified by its
+ * child frame) sorted by time and split into blocks of a fixed number of
+ * samples. A block table stores the time range of every block. A lookup
+ * searches the block table of the edge, then only the samples of the one
+ * block covering the requested time, so the memory-mapped file is paged
+ * in just around the queried times. Static edges keep their latest value.
+ *
+ * The mapping is never written after construction, so any number of
+ * threads may look up edges concurrently without locking.
+ */
+class TransformOfflineIndex: public TransformChainResolver::EdgeSource,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformOfflineIndex> Ptr;
+
+	TransformOfflineIndex(const std::string& file);
+	virtual ~TransformOfflineIndex();
+
+	/**
+	 * Create the index of a log. The index is written to a temporary file
+	 * first and renamed when it is complete.
+	 * \param blockSize number of samples per block
+	 */
+	static void build(const std::string& log, const std::string& file,
+			boost::uint32_t blockSize);
+
+	/** \brief Default name of the index of a log */
+	static std::string indexFile(const std::string& log);
+
+	virtual bool getEdge(const std::string& frame, const boost::posix_time::ptime& time,
+			TransformChainResolver::Edge& edge) const;
+	virtual bool frameExists(const std::string& frame) const;
+
+	std::vector<std::string> getFrameNames() const;
+
+	/** \brief Time range of the dynamic samples, not_a_date_time if there are none */
+	boost::posix_time::ptime getStartTime() const;
+	boost::posix_time::ptime getEndTime() const;
+
+	boost::uint64_t getSampleCount() const;
+	boost::uint64_t getBlockCount() const;
+	boost::uint32_t getBlockSize() const;
+
+	struct Header;
+	struct Frame;
+	struct Block;
+	struct Sample;
+
+private:
+	std::string file;
+	boost::interprocess::file_mapping mapping;
+	boost::interprocess::mapped_region region;
+	const Header* header;
+	const Frame* frames;
+	const Block* blocks;
+	const Sample* samples;
+	std::map<std::string, boost::uint32_t> ids;
+
+	static rsc::logging::LoggerPtr logger;
+
+	const Sample& find(const Frame& frame, boost::int64_t time, const Sample*& next) const;
+	void toEdge(const Sample& sample, bool isStatic, TransformChainResolver::Edge& edge) const;
+};
+
+}  // namespace rct
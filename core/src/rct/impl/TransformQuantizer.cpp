@@ -0,0 +1,159 @@
+/*
+ * TransformQuantizer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformQuantizer.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace rct {
+
+static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+
+boost::int64_t toMicroseconds(const boost::posix_time::ptime& time) {
+	if (time.is_special()) {
+		return 0;
+	}
+	return (time - epoch).total_microseconds();
+}
+
+boost::posix_time::ptime fromMicroseconds(boost::int64_t microseconds) {
+	return epoch + boost::posix_time::microseconds(microseconds);
+}
+
+void quantize(const Transform& transform, double translationResolution,
+		double rotationResolution, boost::int64_t* values) {
+	Eigen::Vector3d t = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+	values[0] = boost::int64_t(floor(t.x() / translationResolution + 0.5));
+	values[1] = boost::int64_t(floor(t.y() / translationResolution + 0.5));
+	values[2] = boost::int64_t(floor(t.z() / translationResolution + 0.5));
+	values[3] = boost::int64_t(floor(q.x() / rotationResolution + 0.5));
+	values[4] = boost::int64_t(floor(q.y() / rotationResolution + 0.5));
+	values[5] = boost::int64_t(floor(q.z() / rotationResolution + 0.5));
+	values[6] = boost::int64_t(floor(q.w() / rotationResolution + 0.5));
+}
+
+Eigen::Affine3d dequantize(const boost::int64_t* values, double translationResolution,
+		double rotationResolution) {
+	Eigen::Translation3d t(values[0] * translationResolution, values[1] * translationResolution,
+			values[2] * translationResolution);
+	Eigen::Quaterniond q(values[6] * rotationResolution, values[3] * rotationResolution,
+			values[4] * rotationResolution, values[5] * rotationResolution);
+	q.normalize();
+	return Eigen::Affine3d(t * q);
+}
+
+TransformQuantizer::TransformQuantizer(double translationResolution, double rotationResolution,
+		unsigned int keyframeInterval) :
+		translationResolution(translationResolution), rotationResolution(rotationResolution), keyframeInterval(
+				std::max(1u, keyframeInterval)), nextEdge(0) {
+	if (translationResolution <= 0 || rotationResolution <= 0) {
+		throw std::invalid_argument("Quantization resolutions must be positive");
+	}
+}
+
+TransformQuantizer::~TransformQuantizer() {
+}
+
+void TransformQuantizer::encode(const Transform& transform, QuantizedTransform& out) {
+	boost::int64_t values[7];
+	quantize(transform, translationResolution, rotationResolution, values);
+	boost::int64_t time = toMicroseconds(transform.getTime());
+
+	pair<string, string> key(transform.getFrameParent(), transform.getFrameChild());
+	map<pair<string, string>, EdgeState>::iterator it = edges.find(key);
+	if (it == edges.end()) {
+		EdgeState state;
+		state.edge = nextEdge++;
+		state.index = 0;
+		state.keyframeRequested = false;
+		it = edges.insert(make_pair(key, state)).first;
+	} else {
+		it->second.index++;
+	}
+	EdgeState& state = it->second;
+
+	out.edge = state.edge;
+	out.index = state.index;
+	out.keyframe = state.keyframeRequested || state.index % keyframeInterval == 0;
+	state.keyframeRequested = false;
+	if (out.keyframe) {
+		out.parent = transform.getFrameParent();
+		out.child = transform.getFrameChild();
+		out.time = time;
+		std::copy(values, values + 7, out.values);
+	} else {
+		out.parent.clear();
+		out.child.clear();
+		out.time = time - state.time;
+		for (int i = 0; i < 7; ++i) {
+			out.values[i] = values[i] - state.values[i];
+		}
+	}
+
+	state.time = time;
+	std::copy(values, values + 7, state.values);
+}
+
+void TransformQuantizer::requestKeyframes() {
+	map<pair<string, string>, EdgeState>::iterator it;
+	for (it = edges.begin(); it != edges.end(); ++it) {
+		it->second.keyframeRequested = true;
+	}
+}
+
+double TransformQuantizer::getTranslationResolution() const {
+	return translationResolution;
+}
+
+double TransformQuantizer::getRotationResolution() const {
+	return rotationResolution;
+}
+
+TransformDequantizer::TransformDequantizer() {
+}
+
+TransformDequantizer::~TransformDequantizer() {
+}
+
+bool TransformDequantizer::decode(const QuantizedTransform& in, double translationResolution,
+		double rotationResolution, Transform& out) {
+	EdgeState& state = edges[in.edge];
+
+	if (in.keyframe) {
+		if (state.valid && state.child == in.child && in.index <= state.index && in.index != 0) {
+			// outdated keyframe
+			return false;
+		}
+		state.parent = in.parent;
+		state.child = in.child;
+		state.time = in.time;
+		std::copy(in.values, in.values + 7, state.values);
+		state.valid = true;
+	} else {
+		if (!state.valid || in.index != state.index + 1) {
+			// depends on a sample we did not receive
+			state.valid = state.valid && in.index <= state.index;
+			return false;
+		}
+		state.time += in.time;
+		for (int i = 0; i < 7; ++i) {
+			state.values[i] += in.values[i];
+		}
+	}
+	state.index = in.index;
+
+	out.setFrameParent(state.parent);
+	out.setFrameChild(state.child);
+	out.setTime(fromMicroseconds(state.time));
+	out.setTransform(dequantize(state.values, translationResolution, rotationResolution));
+	return true;
+}
+
+}  // namespace rct
@@ -0,0 +1,124 @@
+/*
+ * TransformQuantizer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "../Transform.h"
+#include <boost/cstdint.hpp>
+#include <map>
+#include <string>
+
+namespace rct {
+
+/**
+ * A transform in the compact representation produced by TransformQuantizer.
+ *
+ * Frames are replaced by a sender-local edge id. Translation (x, y, z) and
+ * rotation quaternion (x, y, z, w) are integers in multiples of the
+ * configured resolutions. Keyframes carry the frame names, the absolute time
+ * (microseconds since epoch) and absolute values. All other samples carry the
+ * differences to the previous sample of the same edge.
+ */
+class QuantizedTransform {
+public:
+	QuantizedTransform() :
+			edge(0), index(0), keyframe(false), time(0) {
+		for (int i = 0; i < 7; ++i) {
+			values[i] = 0;
+		}
+	}
+	boost::uint32_t edge;
+	// consecutive number of the sample on its edge
+	boost::uint32_t index;
+	bool keyframe;
+	std::string parent;
+	std::string child;
+	boost::int64_t time;
+	boost::int64_t values[7];
+};
+
+/**
+ * Encodes the transforms of one sender into QuantizedTransform samples.
+ *
+ * Differences are taken between quantized values, so the quantization error
+ * does not accumulate. Every keyframeInterval-th sample of an edge is a
+ * keyframe, allowing receivers that missed a sample to resynchronize.
+ */
+class TransformQuantizer {
+public:
+	TransformQuantizer(double translationResolution, double rotationResolution,
+			unsigned int keyframeInterval);
+	virtual ~TransformQuantizer();
+
+	void encode(const Transform& transform, QuantizedTransform& out);
+
+	/** \brief Make the next sample of every edge a keyframe, e.g. for a new receiver */
+	void requestKeyframes();
+
+	double getTranslationResolution() const;
+	double getRotationResolution() const;
+
+private:
+	class EdgeState {
+	public:
+		boost::uint32_t edge;
+		boost::uint32_t index;
+		boost::int64_t time;
+		boost::int64_t values[7];
+		bool keyframeRequested;
+	};
+
+	double translationResolution;
+	double rotationResolution;
+	unsigned int keyframeInterval;
+	std::map<std::pair<std::string, std::string>, EdgeState> edges;
+	boost::uint32_t nextEdge;
+};
+
+/**
+ * Decodes the samples of one sender. Samples following a sample that was
+ * not received are rejected until the next keyframe of their edge.
+ */
+class TransformDequantizer {
+public:
+	TransformDequantizer();
+	virtual ~TransformDequantizer();
+
+	/** \brief Restore a transform.
+	 * \return false if the sample cannot be decoded because a previous one is missing
+	 */
+	bool decode(const QuantizedTransform& in, double translationResolution,
+			double rotationResolution, Transform& out);
+
+private:
+	class EdgeState {
+	public:
+		EdgeState() :
+				index(0), time(0), valid(false) {
+		}
+		std::string parent;
+		std::string child;
+		boost::uint32_t index;
+		boost::int64_t time;
+		boost::int64_t values[7];
+		bool valid;
+	};
+
+	std::map<boost::uint32_t, EdgeState> edges;
+};
+
+/** \brief Microseconds between the epoch and the given time */
+boost::int64_t toMicroseconds(const boost::posix_time::ptime& time);
+boost::posix_time::ptime fromMicroseconds(boost::int64_t microseconds);
+
+/** \brief Translation (x, y, z) and rotation (x, y, z, w) in multiples of the resolutions */
+void quantize(const Transform& transform, double translationResolution,
+		double rotationResolution, boost::int64_t* values);
+Eigen::Affine3d dequantize(const boost::int64_t* values, double translationResolution,
+		double rotationResolution);
+
+}  // namespace rct
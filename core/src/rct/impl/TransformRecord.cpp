@@ -0,0 +1,54 @@
+/*
+ * TransformRecord.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformRecord.h"
+#include "TransformQuantizer.h"
+#include <cstring>
+
+using namespace std;
+
+namespace rct {
+
+bool TransformRecord::copyName(const string& name, char* target) {
+	if (name.size() > maxNameLength) {
+		return false;
+	}
+	memcpy(target, name.c_str(), name.size() + 1);
+	return true;
+}
+
+bool TransformRecord::fromTransform(const Transform& transform) {
+	memset(this, 0, sizeof(TransformRecord));
+	if (!copyName(transform.getFrameParent(), parent) || !copyName(transform.getFrameChild(), child)
+			|| !copyName(transform.getAuthority(), authority)) {
+		return false;
+	}
+	time = toMicroseconds(transform.getTime());
+	Eigen::Vector3d t = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+	translation[0] = t.x();
+	translation[1] = t.y();
+	translation[2] = t.z();
+	rotation[0] = q.x();
+	rotation[1] = q.y();
+	rotation[2] = q.z();
+	rotation[3] = q.w();
+	return true;
+}
+
+void TransformRecord::toTransform(Transform& transform) const {
+	// records may come from foreign memory, never read beyond the fields
+	transform.setFrameParent(string(parent, strnlen(parent, nameSize)));
+	transform.setFrameChild(string(child, strnlen(child, nameSize)));
+	transform.setAuthority(string(authority, strnlen(authority, nameSize)));
+	transform.setTime(fromMicroseconds(time));
+	Eigen::Translation3d t(translation[0], translation[1], translation[2]);
+	Eigen::Quaterniond q(rotation[3], rotation[0], rotation[1], rotation[2]);
+	transform.setTransform(Eigen::Affine3d(t * q));
+}
+
+}  // namespace rct
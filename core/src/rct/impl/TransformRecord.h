@@ -0,0 +1,42 @@
+/*
+ * TransformRecord.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "../Transform.h"
+#include <boost/cstdint.hpp>
+
+namespace rct {
+
+/**
+ * Fixed-layout representation of a transform for files and shared memory.
+ *
+ * The layout only consists of fixed size fields and is meant to be read
+ * in place by processes of the same architecture. Names are zero
+ * terminated and limited to maxNameLength characters.
+ */
+struct TransformRecord {
+	static const size_t nameSize = 64;
+	static const size_t maxNameLength = nameSize - 1;
+
+	char parent[nameSize];
+	char child[nameSize];
+	char authority[nameSize];
+	// microseconds since epoch
+	boost::int64_t time;
+	double translation[3];
+	// x, y, z, w
+	double rotation[4];
+
+	/** \return false if a name is too long to be stored */
+	bool fromTransform(const Transform& transform);
+	void toTransform(Transform& transform) const;
+
+	static bool copyName(const std::string& name, char* target);
+};
+
+}  // namespace rct
@@ -0,0 +1,65 @@
+/*
+ * TransformRecorder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformRecorder.h"
+
+using namespace std;
+
+namespace rct {
+
+static const boost::posix_time::time_duration flushInterval = boost::posix_time::seconds(1);
+
+TransformRecorder::TransformRecorder(const string& file) :
+		file(file), writer(file, 1024, flushInterval), running(true) {
+	flusher = boost::thread(&TransformRecorder::flushPeriodically, this);
+}
+
+TransformRecorder::~TransformRecorder() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		running = false;
+	}
+	flushCondition.notify_all();
+	flusher.join();
+}
+
+void TransformRecorder::flushPeriodically() {
+	boost::mutex::scoped_lock lock(mutex);
+	while (running) {
+		// the writer flushes while writing, this covers the last samples
+		// before the traffic stops
+		flushCondition.timed_wait(lock, flushInterval);
+		writer.flush();
+	}
+}
+
+void TransformRecorder::newTransformAvailable(const Transform& transform, bool isStatic) {
+	boost::mutex::scoped_lock lock(mutex);
+	writer.write(transform, isStatic);
+}
+
+void TransformRecorder::newTransformsAvailable(const vector<Transform>& transforms,
+		bool isStatic) {
+	boost::mutex::scoped_lock lock(mutex);
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		writer.write(*it, isStatic);
+	}
+}
+
+void TransformRecorder::flush() {
+	boost::mutex::scoped_lock lock(mutex);
+	writer.flush();
+}
+
+void TransformRecorder::printContents(std::ostream& stream) const {
+	boost::mutex::scoped_lock lock(mutex);
+	stream << "file = " << file;
+	stream << ", #recorded = " << writer.getCount();
+}
+
+}  // namespace rct
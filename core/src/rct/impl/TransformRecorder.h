@@ -0,0 +1,54 @@
+/*
+ * TransformRecorder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformListener.h"
+#include "TransformLog.h"
+#include <rsc/runtime/Printable.h>
+#include <boost/noncopyable.hpp>
+#include <boost/thread.hpp>
+
+namespace rct {
+
+/**
+ * Writes every received transform to a TransformLog, e.g. to replay the
+ * traffic later with TransformCommReplay.
+ *
+ * Entries are buffered and written to disk when the buffer fills, on
+ * flush(), on destruction and at least every second, also when no more
+ * transforms arrive.
+ */
+class TransformRecorder: public TransformListener,
+		public virtual rsc::runtime::Printable,
+		public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformRecorder> Ptr;
+
+	TransformRecorder(const std::string& file);
+	virtual ~TransformRecorder();
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic);
+
+	void flush();
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	std::string file;
+	mutable boost::mutex mutex;
+	TransformLogWriter writer;
+
+	boost::thread flusher;
+	boost::condition_variable flushCondition;
+	bool running;
+
+	void flushPeriodically();
+};
+
+}  // namespace rct
@@ -43,6 +43,20 @@ public:
 	 */
 	virtual bool setTransform(const Transform& transform, bool is_static = false) = 0;
 
+	/** \brief Add several transforms to the rct data structure at once
+	 * \param transforms The transforms to store
+	 * \param is_static Record these transforms as static transforms.
+	 * \return True unless an error occured
+	 */
+	virtual bool setTransforms(const std::vector<Transform>& transforms, bool is_static = false) {
+		bool result = true;
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			result = setTransform(*it, is_static) && result;
+		}
+		return result;
+	}
+
 	/** \brief Get the transform between two frames by frame ID.
 	 * \param target_frame The frame to which data should be transformed
 	 * \param source_frame The frame where the data originated
@@ -0,0 +1,62 @@
+/*
+ * TransformerCoreRegistry.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformerCoreRegistry.h"
+#include <boost/algorithm/string.hpp>
+
+using namespace std;
+
+namespace rct {
+
+// function local statics, registrars of other translation units may run first
+TransformerCoreRegistry::Creators& TransformerCoreRegistry::getCreators() {
+	static Creators creators;
+	return creators;
+}
+
+boost::mutex& TransformerCoreRegistry::getMutex() {
+	static boost::mutex mutex;
+	return mutex;
+}
+
+void TransformerCoreRegistry::add(const string& name, const Creator& creator) {
+	boost::mutex::scoped_lock lock(getMutex());
+	getCreators()[boost::algorithm::to_upper_copy(name)] = creator;
+}
+
+bool TransformerCoreRegistry::has(const string& name) {
+	boost::mutex::scoped_lock lock(getMutex());
+	return getCreators().count(boost::algorithm::to_upper_copy(name)) > 0;
+}
+
+vector<string> TransformerCoreRegistry::getNames() {
+	boost::mutex::scoped_lock lock(getMutex());
+	vector<string> names;
+	Creators::const_iterator it;
+	for (it = getCreators().begin(); it != getCreators().end(); ++it) {
+		names.push_back(it->first);
+	}
+	return names;
+}
+
+TransformerCore::Ptr TransformerCoreRegistry::create(const string& name,
+		const TransformerConfig& config, bool& attached) {
+	Creator creator;
+	{
+		boost::mutex::scoped_lock lock(getMutex());
+		Creators::const_iterator it = getCreators().find(boost::algorithm::to_upper_copy(name));
+		if (it == getCreators().end()) {
+			return TransformerCore::Ptr();
+		}
+		creator = it->second;
+	}
+	// construction may take long (e.g. building an index), never under the lock
+	attached = false;
+	return creator(config, attached);
+}
+
+}  // namespace rct
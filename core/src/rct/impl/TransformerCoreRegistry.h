@@ -0,0 +1,65 @@
+/*
+ * TransformerCoreRegistry.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformerCore.h"
+#include "../TransformerConfig.h"
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+
+namespace rct {
+
+/**
+ * Core backends available to the factory, keyed by the value of the
+ * `core.type' option.
+ *
+ * Backends of this library register themselves at link time with a static
+ * Registrar in their translation unit. Backends living in an optional
+ * library (e.g. the shared memory core) export a registration function
+ * instead, which the factory calls if the library was built: nothing else
+ * references such a library, so linkers using --as-needed would drop it
+ * together with its registrar.
+ * The creator receives the whole configuration and reads its own tuning
+ * options, usually from TransformerConfig::getCoreOptions().
+ */
+class TransformerCoreRegistry {
+public:
+	/**
+	 * Creates a core for the configuration. Sets attached if the core is
+	 * filled by another process or from a file instead of by the receiver.
+	 */
+	typedef boost::function<TransformerCore::Ptr(const TransformerConfig& config, bool& attached)> Creator;
+
+	class Registrar {
+	public:
+		Registrar(const std::string& name, const Creator& creator) {
+			TransformerCoreRegistry::add(name, creator);
+		}
+	};
+
+	/** \brief Register a backend, replacing one of the same name */
+	static void add(const std::string& name, const Creator& creator);
+
+	static bool has(const std::string& name);
+	static std::vector<std::string> getNames();
+
+	/** \brief Create a core of the named backend.
+	 * \return null if no backend of this name is registered
+	 */
+	static TransformerCore::Ptr create(const std::string& name, const TransformerConfig& config,
+			bool& attached);
+
+private:
+	typedef std::map<std::string, Creator> Creators;
+
+	static Creators& getCreators();
+	static boost::mutex& getMutex();
+};
+
+}  // namespace rct
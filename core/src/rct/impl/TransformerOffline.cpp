@@ -0,0 +1,171 @@
+/*
+ * TransformerOffline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformerOffline.h"
+#include "TransformerCoreRegistry.h"
+#include <boost/filesystem.hpp>
+#include <sstream>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformerOffline::logger = rsc::logging::Logger::getLogger(
+		"rct.core.TransformerOffline");
+
+static TransformerCore::Ptr createCore(const TransformerConfig& config, bool& attached) {
+	// lookups read the log, nothing is received
+	attached = true;
+	return TransformerCore::Ptr(
+			new TransformerOffline(config.getCoreOption<string>("offline", "file", ""),
+					config.getCoreOption<boost::uint32_t>("offline", "blocksize", 1024)));
+}
+
+static TransformerCoreRegistry::Registrar registrar("OFFLINE", &createCore);
+
+TransformerOffline::TransformerOffline(const string& log, boost::uint32_t blockSize) :
+		log(log), index(open(log, blockSize)), resolver(*index) {
+}
+
+TransformerOffline::~TransformerOffline() {
+}
+
+TransformOfflineIndex::Ptr TransformerOffline::open(const string& log,
+		boost::uint32_t blockSize) {
+	string file = TransformOfflineIndex::indexFile(log);
+	if (!boost::filesystem::exists(file)
+			|| boost::filesystem::last_write_time(file)
+					< boost::filesystem::last_write_time(log)) {
+		RSCINFO(logger, "Indexing " << log);
+		TransformOfflineIndex::build(log, file, blockSize);
+	}
+	return TransformOfflineIndex::Ptr(new TransformOfflineIndex(file));
+}
+
+void TransformerOffline::clear() {
+	RSCWARN(logger, "Can not clear offline data of " << log);
+}
+
+bool TransformerOffline::setTransform(const Transform& transform, bool is_static) {
+	RSCTRACE(logger, "Ignoring transform, offline data is read-only");
+	return false;
+}
+
+Transform TransformerOffline::lookupTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) const {
+	return resolver.lookupTransform(target_frame, source_frame, time);
+}
+
+Transform TransformerOffline::lookupTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame) const {
+	return resolver.lookupTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame);
+}
+
+TransformerOffline::FuturePtr TransformerOffline::requestTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) {
+	FuturePtr result(new FutureType());
+	try {
+		result->set(lookupTransform(target_frame, source_frame, time));
+	} catch (std::exception &e) {
+		result->setError(e.what());
+	}
+	return result;
+}
+
+bool TransformerOffline::canTransform(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time, string* error_msg) const {
+	return resolver.canTransform(target_frame, source_frame, time, error_msg);
+}
+
+bool TransformerOffline::canTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame,
+		string* error_msg) const {
+	return resolver.canTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame, error_msg);
+}
+
+vector<string> TransformerOffline::getFrameStrings() const {
+	return index->getFrameNames();
+}
+
+bool TransformerOffline::frameExists(const string& frame_id_str) const {
+	return index->frameExists(frame_id_str);
+}
+
+string TransformerOffline::getParent(const string& frame_id,
+		const boost::posix_time::ptime& time) const {
+	return resolver.getParent(frame_id, time);
+}
+
+string TransformerOffline::allFramesAsDot() const {
+	stringstream dot;
+	dot << "digraph G {" << endl;
+	vector<string> frames = index->getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			dot << "\"" << parent << "\" -> \"" << *it << "\";" << endl;
+		}
+	}
+	dot << "}";
+	return dot.str();
+}
+
+string TransformerOffline::allFramesAsYAML() const {
+	stringstream yaml;
+	vector<string> frames = index->getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			yaml << *it << ": " << endl;
+			yaml << "  parent: '" << parent << "'" << endl;
+		}
+	}
+	return yaml.str();
+}
+
+string TransformerOffline::allFramesAsString() const {
+	stringstream text;
+	vector<string> frames = index->getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			text << "Frame " << *it << " exists with parent " << parent << "." << endl;
+		}
+	}
+	return text.str();
+}
+
+void TransformerOffline::newTransformAvailable(const Transform& transform, bool isStatic) {
+	setTransform(transform, isStatic);
+}
+
+void TransformerOffline::newTransformsAvailable(const vector<Transform>& transforms,
+		bool isStatic) {
+	setTransforms(transforms, isStatic);
+}
+
+const TransformOfflineIndex& TransformerOffline::getIndex() const {
+	return *index;
+}
+
+void TransformerOffline::printContents(ostream& stream) const {
+	stream << "backend = offline";
+	stream << ", log = " << log;
+	stream << ", start = " << index->getStartTime();
+	stream << ", end = " << index->getEndTime();
+	stream << ", #samples = " << index->getSampleCount();
+	stream << ", blockSize = " << index->getBlockSize();
+}
+
+}  // namespace rct
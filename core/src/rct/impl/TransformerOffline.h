@@ -0,0 +1,86 @@
+/*
+ * TransformerOffline.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include "TransformerCore.h"
+#include "TransformChainResolver.h"
+#include "TransformOfflineIndex.h"
+#include <rsc/logging/Logger.h>
+
+namespace rct {
+
+/**
+ * Read-only core answering lookups from a recorded TransformLog, e.g. for
+ * offline mapping and evaluation over hours of data.
+ *
+ * The log is indexed once into a TransformOfflineIndex next to it, the
+ * index is rebuilt if it is missing or older than the log. Received
+ * transforms are ignored. Lookups do not lock, so the core can be queried
+ * from many threads in parallel.
+ */
+class TransformerOffline: public TransformerCore {
+public:
+	typedef boost::shared_ptr<TransformerOffline> Ptr;
+
+	/**
+	 * \param log recorded TransformLog
+	 * \param blockSize samples per block if the index has to be built
+	 */
+	TransformerOffline(const std::string& log, boost::uint32_t blockSize);
+	virtual ~TransformerOffline();
+
+	/** \brief Not supported, the data is read-only */
+	virtual void clear();
+
+	/** \brief Not supported, always false */
+	virtual bool setTransform(const Transform& transform, bool is_static = false);
+
+	virtual Transform lookupTransform(const std::string& target_frame,
+			const std::string& source_frame, const boost::posix_time::ptime& time) const;
+	virtual Transform lookupTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame) const;
+
+	/** \brief Resolved immediately, the data never changes */
+	virtual FuturePtr requestTransform(const std::string& target_frame,
+			const std::string& source_frame, const boost::posix_time::ptime& time);
+
+	virtual bool canTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time, std::string* error_msg = NULL) const;
+	virtual bool canTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame,
+			std::string* error_msg = NULL) const;
+
+	virtual std::vector<std::string> getFrameStrings() const;
+	virtual bool frameExists(const std::string& frame_id_str) const;
+	virtual std::string getParent(const std::string& frame_id,
+			const boost::posix_time::ptime& time) const;
+
+	virtual std::string allFramesAsDot() const;
+	virtual std::string allFramesAsYAML() const;
+	virtual std::string allFramesAsString() const;
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic);
+
+	const TransformOfflineIndex& getIndex() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	std::string log;
+	TransformOfflineIndex::Ptr index;
+	TransformChainResolver resolver;
+
+	static rsc::logging::LoggerPtr logger;
+
+	static TransformOfflineIndex::Ptr open(const std::string& log, boost::uint32_t blockSize);
+};
+
+}  // namespace rct
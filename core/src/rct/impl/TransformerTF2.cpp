@@ -6,6 +6,7 @@
  */
 
 #include "../impl/TransformerTF2.h"
+#include "../impl/TransformerCoreRegistry.h"
 
 #include <boost/algorithm/string.hpp>
 
@@ -20,8 +21,21 @@ namespace rct {
 
 rsc::logging::LoggerPtr TransformerTF2::logger = rsc::logging::Logger::getLogger("rct.core.TransformerTF2");
 
-TransformerTF2::TransformerTF2(const posix_time::time_duration& cacheTime) :
-		tfBuffer(ros::Duration().fromNSec(cacheTime.total_nanoseconds())) {
+static TransformerCore::Ptr createCore(const TransformerConfig& config, bool&) {
+	TransformHistory::Ptr history;
+	if (config.getHistoryTime() > config.getCacheTime()) {
+		history = TransformHistory::Ptr(
+				new TransformHistory(config.getHistoryTime(), config.getTranslationResolution(),
+						config.getRotationResolution()));
+	}
+	return TransformerCore::Ptr(new TransformerTF2(config.getCacheTime(), history));
+}
+
+static TransformerCoreRegistry::Registrar registrar("TF2", &createCore);
+
+TransformerTF2::TransformerTF2(const posix_time::time_duration& cacheTime,
+		const TransformHistory::Ptr& history) :
+		tfBuffer(ros::Duration().fromNSec(cacheTime.total_nanoseconds())), history(history), deferredChanges(0) {
 
 	tfBuffer._addTransformsChangedListener(bind(&TransformerTF2::tfChanged, this));
 }
@@ -60,6 +74,9 @@ void TransformerTF2::convertTfToTransform(const geometry_msgs::TransformStamped
 
 void TransformerTF2::clear() {
 	tfBuffer.clear();
+	if (history) {
+		history->clear();
+	}
 }
 
 bool TransformerTF2::setTransform(const Transform& transform_in, bool is_static) {
@@ -67,13 +84,44 @@ bool TransformerTF2::setTransform(const Transform& transform_in, bool is_static)
 	geometry_msgs::TransformStamped t;
 	convertTransformToTf(transform_in, t);
 
+	if (history) {
+		history->add(transform_in, is_static);
+	}
 	return tfBuffer.setTransform(t, transform_in.getAuthority(), is_static);
 }
 
+bool TransformerTF2::setTransforms(const std::vector<Transform>& transforms, bool is_static) {
+
+	bool result = true;
+	if (history) {
+		history->add(transforms, is_static);
+	}
+	deferredChanges++;
+	std::vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		geometry_msgs::TransformStamped t;
+		convertTransformToTf(*it, t);
+		result = tfBuffer.setTransform(t, it->getAuthority(), is_static) && result;
+	}
+	deferredChanges--;
+
+	tfChanged();
+	return result;
+}
+
 Transform TransformerTF2::lookupTransform(const std::string& target_frame,
 		const std::string& source_frame, const posix_time::ptime& time) const {
 
-	geometry_msgs::TransformStamped t0 = tfBuffer.lookupTransform(target_frame, source_frame, ros::Time().fromBoost(time));
+	geometry_msgs::TransformStamped t0;
+	try {
+		t0 = tfBuffer.lookupTransform(target_frame, source_frame, ros::Time().fromBoost(time));
+	} catch (tf2::ExtrapolationException &e) {
+		if (!history) {
+			throw;
+		}
+		RSCTRACE(this->logger, "Not in the buffer any more. Look up in the history.");
+		return history->lookupTransform(target_frame, source_frame, time);
+	}
 	Transform t1;
 	convertTfToTransform(t0, t1);
 	return t1;
@@ -83,7 +131,17 @@ Transform TransformerTF2::lookupTransform(const std::string& target_frame,
 		const posix_time::ptime& target_time, const std::string& source_frame,
 		const posix_time::ptime& source_time,
 		const std::string& fixed_frame) const {
-	geometry_msgs::TransformStamped t0 = tfBuffer.lookupTransform(target_frame, ros::Time().fromBoost(target_time), source_frame, ros::Time().fromBoost(source_time), fixed_frame);
+	geometry_msgs::TransformStamped t0;
+	try {
+		t0 = tfBuffer.lookupTransform(target_frame, ros::Time().fromBoost(target_time), source_frame, ros::Time().fromBoost(source_time), fixed_frame);
+	} catch (tf2::ExtrapolationException &e) {
+		if (!history) {
+			throw;
+		}
+		RSCTRACE(this->logger, "Not in the buffer any more. Look up in the history.");
+		return history->lookupTransform(target_frame, target_time, source_frame, source_time,
+				fixed_frame);
+	}
 	Transform t1;
 	convertTfToTransform(t0, t1);
 	return t1;
@@ -93,9 +151,16 @@ TransformerTF2::FuturePtr TransformerTF2::requestTransform(
 		const std::string& target_frame, const std::string& source_frame,
 		const boost::posix_time::ptime& time) {
 
-	FuturePtr result(new FutureType());
+	Request request(target_frame, source_frame, ros::Time().fromBoost(time));
 
 	boost::mutex::scoped_lock lock(inprogressMutex);
+	std::map<Request, FuturePtr>::iterator pending = requestsInProgress.find(request);
+	if (pending != requestsInProgress.end()) {
+		RSCTRACE(this->logger, "Identical request already pending. Share its result.");
+		return pending->second;
+	}
+
+	FuturePtr result(new FutureType());
 	try {
 		Transform t = lookupTransform(target_frame, source_frame, time);
 		result->set(t);
@@ -105,22 +170,23 @@ TransformerTF2::FuturePtr TransformerTF2::requestTransform(
 
 		RSCTRACE(this->logger, "Lookup NOT possible before request applies. Register request.");
 
-		this->requestsInProgress.insert(
-				std::make_pair(Request(target_frame, source_frame, ros::Time().fromBoost(time)),
-						result));
+		this->requestsInProgress.insert(std::make_pair(request, result));
 	} catch (tf2::ExtrapolationException &e) {
 
 		RSCTRACE(this->logger, "Lookup NOT possible before request applies. Register request.");
 
-		this->requestsInProgress.insert(
-				std::make_pair(Request(target_frame, source_frame, ros::Time().fromBoost(time)),
-						result));
+		this->requestsInProgress.insert(std::make_pair(request, result));
 	}
 
 	return result;
 }
 
 void TransformerTF2::tfChanged() {
+	if (deferredChanges > 0) {
+		// a batch is being inserted; it calls tfChanged() once it is complete
+		return;
+	}
+
 	boost::mutex::scoped_lock lock(inprogressMutex);
 
 	if (firstChangeTime.isZero()) {
@@ -128,8 +194,8 @@ void TransformerTF2::tfChanged() {
 		firstChangeTime = ros::Time().fromBoost(now);
 	}
 
-	std::map<Request, FuturePtr>::iterator it;
-	for (it = requestsInProgress.begin(); it != requestsInProgress.end(); ++it) {
+	std::map<Request, FuturePtr>::iterator it = requestsInProgress.begin();
+	while (it != requestsInProgress.end()) {
 		try {
 			ros::Time t = it->first.time;
 			if (t < firstChangeTime) {
@@ -140,34 +206,54 @@ void TransformerTF2::tfChanged() {
 			Transform t1;
 			convertTfToTransform(t0, t1);
 			it->second->set(t1);
-			requestsInProgress.erase(it);
+			requestsInProgress.erase(it++);
+			continue;
 		} catch (tf2::LookupException &e) {
 			RSCTRACE(this->logger, "Not yet transformable ");
 		} catch (tf2::ExtrapolationException &e) {
 			RSCTRACE(this->logger, "Not yet transformable ");
 		}
+		++it;
 	}
 }
 
 bool TransformerTF2::canTransform(const std::string& target_frame, const std::string& source_frame,
 		const posix_time::ptime& time, std::string* error_msg) const {
-	return tfBuffer.canTransform(target_frame, source_frame, ros::Time().fromBoost(time), error_msg);
+	if (tfBuffer.canTransform(target_frame, source_frame, ros::Time().fromBoost(time), error_msg)) {
+		return true;
+	}
+	return history && history->canTransform(target_frame, source_frame, time, error_msg);
 }
 
 bool TransformerTF2::canTransform(const std::string& target_frame,
 		const posix_time::ptime& target_time, const std::string& source_frame,
 		const posix_time::ptime& source_time, const std::string& fixed_frame,
 		std::string* error_msg) const {
-	return tfBuffer.canTransform(target_frame, ros::Time().fromBoost(target_time), source_frame,
-			ros::Time().fromBoost(source_time), fixed_frame, error_msg);
+	if (tfBuffer.canTransform(target_frame, ros::Time().fromBoost(target_time), source_frame,
+			ros::Time().fromBoost(source_time), fixed_frame, error_msg)) {
+		return true;
+	}
+	return history
+			&& history->canTransform(target_frame, target_time, source_frame, source_time,
+					fixed_frame, error_msg);
 }
 
 void TransformerTF2::newTransformAvailable(const rct::Transform& t, bool isStatic) {
 	setTransform(t, isStatic);
 }
 
+void TransformerTF2::newTransformsAvailable(const std::vector<rct::Transform>& transforms,
+		bool isStatic) {
+	setTransforms(transforms, isStatic);
+}
+
 void TransformerTF2::printContents(std::ostream& stream) const {
 	stream << "backend = tf2::BufferCore";
+	if (history) {
+		stream << ", history = {";
+		history->printContents(stream);
+		stream << "}";
+	}
 }
 
 std::vector<std::string> TransformerTF2::getFrameStrings() const {
@@ -8,8 +8,10 @@
 #pragma once
 
 #include "TransformerCore.h"
+#include "TransformHistory.h"
 #include <tf2/buffer_core.h>
 #include <rsc/logging/Logger.h>
+#include <boost/atomic.hpp>
 
 namespace rct {
 
@@ -19,7 +21,13 @@ public:
 	typedef rsc::threading::Future<Transform> FutureType;
 	typedef boost::shared_ptr<FutureType> FuturePtr;
 
-	TransformerTF2(const boost::posix_time::time_duration& cacheTime);
+	/**
+	 * \param cacheTime time the tf2 buffer keeps samples uncompressed
+	 * \param history optional compressed tier answering lookups older
+	 *                than the cache time
+	 */
+	TransformerTF2(const boost::posix_time::time_duration& cacheTime,
+			const TransformHistory::Ptr& history = TransformHistory::Ptr());
 	virtual ~TransformerTF2();
 
 	/** \brief Clear all data */
@@ -33,6 +41,11 @@ public:
 	 */
 	virtual bool setTransform(const Transform& transform, bool is_static = false);
 
+	/** \brief Add several transforms at once. Pending requests are evaluated
+	 * once after the whole batch instead of after every single transform.
+	 */
+	virtual bool setTransforms(const std::vector<Transform>& transforms, bool is_static = false);
+
 	/** \brief Get the transform between two frames by frame ID.
 	 * \param target_frame The frame to which data should be transformed
 	 * \param source_frame The frame where the data originated
@@ -128,6 +141,7 @@ public:
 	void printContents(std::ostream& stream) const;
 
 	virtual void newTransformAvailable(const rct::Transform&, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<rct::Transform>&, bool isStatic);
 
 private:
 	class Request {
@@ -139,14 +153,23 @@ private:
 				target_frame(target_frame), source_frame(source_frame), time(time) {
 		}
 		bool operator<(const Request &r) const {
-			return time < r.time;
+			if (time != r.time) {
+				return time < r.time;
+			}
+			if (target_frame != r.target_frame) {
+				return target_frame < r.target_frame;
+			}
+			return source_frame < r.source_frame;
 		}
 	};
 
 	tf2::BufferCore tfBuffer;
+	TransformHistory::Ptr history;
 	boost::mutex inprogressMutex;
+	// identical pending requests share one future
 	std::map<Request, FuturePtr> requestsInProgress;
 	ros::Time firstChangeTime;
+	boost::atomic<int> deferredChanges;
 	static rsc::logging::LoggerPtr logger;
 
 	void tfChanged();
@@ -0,0 +1,30 @@
+/*
+ * TestCheck.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <iostream>
+
+/**
+ * Minimal assertion for the test executables. A failed check is reported
+ * and counted, the test returns the number of failures.
+ */
+#define RCT_CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl; \
+			rct::test::failures++; \
+		} \
+	} while (0)
+
+namespace rct {
+namespace test {
+
+static int failures = 0;
+
+}  // namespace test
+}  // namespace rct
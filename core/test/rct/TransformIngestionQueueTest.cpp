@@ -0,0 +1,147 @@
+/*
+ * TransformIngestionQueueTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TestCheck.h"
+#include <rct/impl/TransformIngestionQueue.h>
+#include <boost/thread/condition_variable.hpp>
+#include <vector>
+
+using namespace std;
+using namespace rct;
+using namespace boost::posix_time;
+
+/**
+ * Records the dynamic transforms it gets by their x translation. The first
+ * delivery blocks until released, so the queue fills up behind it.
+ */
+class BlockingListener: public TransformListener {
+public:
+	BlockingListener() :
+			blocked(false), released(false) {
+	}
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic) {
+		boost::mutex::scoped_lock lock(mutex);
+		if (!isStatic) {
+			received.push_back(int(transform.getTranslation().x()));
+		}
+		blocked = true;
+		condition.notify_all();
+		while (!released) {
+			condition.wait(lock);
+		}
+	}
+
+	void waitBlocked() {
+		boost::mutex::scoped_lock lock(mutex);
+		while (!blocked) {
+			condition.wait(lock);
+		}
+	}
+
+	void release() {
+		boost::mutex::scoped_lock lock(mutex);
+		released = true;
+		condition.notify_all();
+	}
+
+	vector<int> getReceived() {
+		boost::mutex::scoped_lock lock(mutex);
+		return received;
+	}
+
+	void printContents(std::ostream& stream) const {
+	}
+
+private:
+	boost::mutex mutex;
+	boost::condition_variable condition;
+	bool blocked;
+	bool released;
+	vector<int> received;
+};
+
+static Transform sample(int i) {
+	return Transform(Eigen::Affine3d(Eigen::Translation3d(i, 0, 0)), "odom", "base",
+			microsec_clock::universal_time());
+}
+
+static void waitProcessed(const TransformIngestionQueue& queue, unsigned long count) {
+	for (int i = 0; i < 500 && queue.getProcessed() < count; ++i) {
+		boost::this_thread::sleep(milliseconds(10));
+	}
+}
+
+/**
+ * Fills a queue of the given depth while its only worker is blocked and
+ * returns what was delivered after releasing it.
+ */
+static vector<int> overflow(TransformerConfig::DropPolicy policy, size_t depth, int overflowCount,
+		unsigned long& dropped) {
+	boost::shared_ptr<BlockingListener> listener(new BlockingListener());
+	TransformerConfig config;
+	config.setIngestionDepth(depth);
+	config.setIngestionWorkers(1);
+	config.setIngestionDropPolicy(policy);
+	TransformIngestionQueue queue(vector<TransformListener::Ptr>(1, listener), config);
+
+	queue.newTransformAvailable(sample(0), false);
+	listener->waitBlocked();
+	for (int i = 1; i <= int(depth) + overflowCount; ++i) {
+		queue.newTransformAvailable(sample(i), false);
+	}
+	dropped = queue.getDropped();
+
+	listener->release();
+	waitProcessed(queue, 1 + depth);
+	queue.shutdown();
+	return listener->getReceived();
+}
+
+static void testDropNewest() {
+	unsigned long dropped;
+	vector<int> received = overflow(TransformerConfig::DROP_NEWEST, 8, 5, dropped);
+	RCT_CHECK(dropped == 5);
+	RCT_CHECK(received.size() == 9);
+	for (size_t i = 0; i < received.size(); ++i) {
+		// the queued transforms are kept, the late ones are dropped
+		RCT_CHECK(received[i] == int(i));
+	}
+}
+
+static void testDropOldest() {
+	unsigned long dropped;
+	vector<int> received = overflow(TransformerConfig::DROP_OLDEST, 8, 5, dropped);
+	RCT_CHECK(dropped == 5);
+	RCT_CHECK(received.size() == 9);
+	if (received.size() == 9) {
+		RCT_CHECK(received[0] == 0);
+		for (size_t i = 1; i < received.size(); ++i) {
+			// the first queued transforms made room for the latest ones
+			RCT_CHECK(received[i] == int(i) + 5);
+		}
+	}
+}
+
+static void testInvalidDepth() {
+	TransformerConfig config;
+	config.setIngestionDepth(0);
+	bool thrown = false;
+	try {
+		TransformIngestionQueue queue(vector<TransformListener::Ptr>(), config);
+	} catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	RCT_CHECK(thrown);
+}
+
+int main() {
+	testDropNewest();
+	testDropOldest();
+	testInvalidDepth();
+	return rct::test::failures;
+}
@@ -0,0 +1,170 @@
+/*
+ * TransformLogTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TestCheck.h"
+#include <rct/impl/TransformLog.h>
+#include <boost/filesystem.hpp>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace rct;
+using namespace boost::posix_time;
+
+static const int sampleCount = 5000;
+
+static ptime start() {
+	return time_from_string("2026-10-19 10:00:00");
+}
+
+static Transform dynamicSample(int i) {
+	Transform transform(Eigen::Affine3d(Eigen::Translation3d(0.001 * i, 2, 3)), "odom", "base",
+			start() + milliseconds(i));
+	transform.setAuthority("localization");
+	return transform;
+}
+
+static Transform staticSample(const string& child, double x, int i) {
+	return Transform(Eigen::Affine3d(Eigen::Translation3d(x, 0, 0)), "base", child,
+			start() + milliseconds(i));
+}
+
+static void writeLog(const string& file) {
+	TransformLogWriter writer(file, 256);
+	writer.write(staticSample("laser", 1, 0), true, start());
+	for (int i = 0; i < sampleCount; ++i) {
+		if (i == 2500) {
+			writer.write(staticSample("camera", 2, i), true, start() + milliseconds(i));
+		}
+		if (i == 4000) {
+			// replaces the laser static from here on
+			writer.write(staticSample("laser", 3, i), true, start() + milliseconds(i));
+		}
+		// received with a delay, sensor time stamps are older
+		writer.write(dynamicSample(i), false, start() + milliseconds(i + 20));
+	}
+	writer.flush();
+	RCT_CHECK(writer.getCount() == sampleCount + 3);
+}
+
+static void testRoundTrip(const string& file) {
+	TransformLogReader reader(file);
+	RCT_CHECK(reader.getStartTime() == start());
+	RCT_CHECK(!reader.getIndex().empty());
+
+	Transform transform;
+	bool isStatic;
+	ptime received;
+	int dynamics = 0;
+	int statics = 0;
+	while (reader.next(transform, isStatic, received)) {
+		if (isStatic) {
+			statics++;
+			continue;
+		}
+		RCT_CHECK(transform.getTime() == start() + milliseconds(dynamics));
+		RCT_CHECK(received == transform.getTime() + milliseconds(20));
+		RCT_CHECK(transform.getFrameParent() == "odom");
+		RCT_CHECK(transform.getFrameChild() == "base");
+		RCT_CHECK(transform.getAuthority() == "localization");
+		RCT_CHECK(transform.getTranslation().isApprox(Eigen::Vector3d(0.001 * dynamics, 2, 3)));
+		dynamics++;
+	}
+	RCT_CHECK(dynamics == sampleCount);
+	RCT_CHECK(statics == 3);
+
+	reader.rewind();
+	RCT_CHECK(reader.next(transform, isStatic));
+	RCT_CHECK(isStatic && transform.getFrameChild() == "laser");
+}
+
+static void checkSeek(TransformLogReader& reader, int millisecond, size_t expectedStatics,
+		double laserX) {
+	vector<Transform> statics;
+	reader.seek(start() + milliseconds(millisecond), statics);
+	RCT_CHECK(statics.size() == expectedStatics);
+	for (size_t i = 0; i < statics.size(); ++i) {
+		if (statics[i].getFrameChild() == "laser") {
+			RCT_CHECK(statics[i].getTranslation().x() == laserX);
+		}
+	}
+
+	Transform transform;
+	bool isStatic = true;
+	while (isStatic && reader.next(transform, isStatic)) {
+	}
+	RCT_CHECK(!isStatic);
+	RCT_CHECK(transform.getTime() == start() + milliseconds(millisecond));
+}
+
+static void testSeek(const string& file) {
+	TransformLogReader reader(file);
+	checkSeek(reader, 3000, 2, 1);
+	checkSeek(reader, 4500, 2, 3);
+	// backwards
+	checkSeek(reader, 100, 1, 1);
+}
+
+static void testSeekWithoutIndex(const string& file) {
+	boost::filesystem::remove(TransformLog::indexFile(file));
+	TransformLogReader reader(file);
+	RCT_CHECK(reader.getIndex().empty());
+	RCT_CHECK(reader.getStartTime() == start());
+	checkSeek(reader, 3000, 2, 1);
+	checkSeek(reader, 4500, 2, 3);
+}
+
+static void testTruncated(const string& file) {
+	// a crash may cut the last entry
+	boost::filesystem::resize_file(file, boost::filesystem::file_size(file) - 7);
+	TransformLogReader reader(file);
+	Transform transform;
+	bool isStatic;
+	int count = 0;
+	while (reader.next(transform, isStatic)) {
+		count++;
+	}
+	RCT_CHECK(count == sampleCount + 2);
+}
+
+static void testVarint() {
+	boost::uint64_t values[] = { 0, 1, 127, 128, 300, 0xffffffffull, 0xffffffffffffffffull };
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+		string buffer;
+		TransformLog::writeVarint(buffer, values[i]);
+		const char* position = buffer.data();
+		boost::uint64_t value = 0;
+		RCT_CHECK(TransformLog::readVarint(position, buffer.data() + buffer.size(), value));
+		RCT_CHECK(value == values[i]);
+		RCT_CHECK(position == buffer.data() + buffer.size());
+
+		// cut off within the varint
+		position = buffer.data();
+		RCT_CHECK(!TransformLog::readVarint(position, buffer.data() + buffer.size() - 1, value));
+	}
+
+	boost::int64_t signedValues[] = { 0, -1, 1, -64, 64, -1000000 };
+	for (size_t i = 0; i < sizeof(signedValues) / sizeof(signedValues[0]); ++i) {
+		RCT_CHECK(TransformLog::unzigzag(TransformLog::zigzag(signedValues[i])) == signedValues[i]);
+	}
+	RCT_CHECK(TransformLog::zigzag(-1) == 1);
+}
+
+int main(int argc, char** argv) {
+	string file = argc > 1 ? argv[1] : "transform-log-test.log";
+
+	testVarint();
+	writeLog(file);
+	testRoundTrip(file);
+	testSeek(file);
+	testSeekWithoutIndex(file);
+	testTruncated(file);
+
+	boost::filesystem::remove(file);
+	boost::filesystem::remove(TransformLog::indexFile(file));
+	return rct::test::failures;
+}
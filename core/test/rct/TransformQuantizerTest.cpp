@@ -0,0 +1,112 @@
+/*
+ * TransformQuantizerTest.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TestCheck.h"
+#include <rct/impl/TransformQuantizer.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace rct;
+using namespace boost::posix_time;
+
+static const double translationResolution = 0.001;
+static const double rotationResolution = 0.0001;
+
+static Transform sample(int i, const ptime& start) {
+	Eigen::Affine3d a(Eigen::Translation3d(0.1 * i, -0.0123 * i, 2.5)
+			* Eigen::AngleAxisd(0.01 * i, Eigen::Vector3d::UnitZ()));
+	return Transform(a, "odom", "base", start + milliseconds(10 * i));
+}
+
+static bool near(const Transform& a, const Transform& b) {
+	double translation = (a.getTranslation() - b.getTranslation()).norm();
+	double rotation = a.getRotationQuat().angularDistance(b.getRotationQuat());
+	return translation <= translationResolution && rotation <= 4 * rotationResolution;
+}
+
+static void testRoundTrip() {
+	ptime start = time_from_string("2026-10-19 10:00:00");
+	TransformQuantizer quantizer(translationResolution, rotationResolution, 10);
+	TransformDequantizer dequantizer;
+
+	for (int i = 0; i < 100; ++i) {
+		Transform in = sample(i, start);
+		QuantizedTransform q;
+		quantizer.encode(in, q);
+		RCT_CHECK(q.keyframe == (i % 10 == 0));
+		RCT_CHECK(q.keyframe || q.child.empty());
+
+		Transform out;
+		RCT_CHECK(dequantizer.decode(q, translationResolution, rotationResolution, out));
+		RCT_CHECK(out.getFrameParent() == "odom");
+		RCT_CHECK(out.getFrameChild() == "base");
+		RCT_CHECK(out.getTime() == in.getTime());
+		// differences of quantized values do not accumulate the error
+		RCT_CHECK(near(in, out));
+	}
+}
+
+static void testMissingSample() {
+	ptime start = time_from_string("2026-10-19 10:00:00");
+	TransformQuantizer quantizer(translationResolution, rotationResolution, 4);
+	TransformDequantizer dequantizer;
+
+	vector<QuantizedTransform> samples(9);
+	for (int i = 0; i < 9; ++i) {
+		quantizer.encode(sample(i, start), samples[i]);
+	}
+
+	Transform out;
+	RCT_CHECK(dequantizer.decode(samples[0], translationResolution, rotationResolution, out));
+	RCT_CHECK(dequantizer.decode(samples[1], translationResolution, rotationResolution, out));
+	// sample 2 is lost, the differences up to the next keyframe are useless
+	RCT_CHECK(!dequantizer.decode(samples[3], translationResolution, rotationResolution, out));
+	RCT_CHECK(dequantizer.decode(samples[4], translationResolution, rotationResolution, out));
+	RCT_CHECK(near(sample(4, start), out));
+	RCT_CHECK(dequantizer.decode(samples[5], translationResolution, rotationResolution, out));
+	RCT_CHECK(near(sample(5, start), out));
+}
+
+static void testRequestKeyframes() {
+	ptime start = time_from_string("2026-10-19 10:00:00");
+	TransformQuantizer quantizer(translationResolution, rotationResolution, 100);
+
+	QuantizedTransform q;
+	quantizer.encode(sample(0, start), q);
+	quantizer.encode(sample(1, start), q);
+	RCT_CHECK(!q.keyframe);
+	quantizer.requestKeyframes();
+	quantizer.encode(sample(2, start), q);
+	RCT_CHECK(q.keyframe);
+	RCT_CHECK(q.child == "base");
+
+	// a receiver joining now can decode from the requested keyframe on
+	TransformDequantizer dequantizer;
+	Transform out;
+	RCT_CHECK(dequantizer.decode(q, translationResolution, rotationResolution, out));
+	RCT_CHECK(near(sample(2, start), out));
+}
+
+static void testInvalidResolution() {
+	bool thrown = false;
+	try {
+		TransformQuantizer quantizer(0, rotationResolution, 10);
+	} catch (const std::invalid_argument&) {
+		thrown = true;
+	}
+	RCT_CHECK(thrown);
+}
+
+int main() {
+	testRoundTrip();
+	testMissingSample();
+	testRequestKeyframes();
+	testInvalidResolution();
+	return rct::test::failures;
+}
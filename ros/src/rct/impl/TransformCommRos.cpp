@@ -21,13 +21,13 @@ rsc::logging::LoggerPtr TransformCommRos::logger = rsc::logging::Logger::getLogg
 
 TransformCommRos::TransformCommRos(const string &name,
 		const boost::posix_time::time_duration& cacheTime, bool legacyMode, long legacyIntervalMSec) :
-		name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
+		tfListener(NULL), name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
 }
 
 TransformCommRos::TransformCommRos(const string &name,
 		const boost::posix_time::time_duration& cacheTime, const TransformListener::Ptr& listener,
 		bool legacyMode, long legacyIntervalMSec) :
-		name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
+		tfListener(NULL), name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
 
 	addTransformListener(listener);
 }
@@ -35,32 +35,47 @@ TransformCommRos::TransformCommRos(const string &name,
 TransformCommRos::TransformCommRos(const string &name,
 		const boost::posix_time::time_duration& cacheTime, const vector<TransformListener::Ptr>& l,
 		bool legacyMode, long legacyIntervalMSec) :
-		name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
+		tfListener(NULL), name(name), legacyMode(legacyMode), running(true), legacyIntervalMSec(legacyIntervalMSec) {
 
 	addTransformListener(l);
 }
 
 TransformCommRos::~TransformCommRos() {
-	running = false;
-	delete tfListener;
+	shutdown();
 }
 
 void TransformCommRos::init(const TransformerConfig &conf) {
 
 	RSCTRACE(logger, "init()");
 
-	TransformCallbackRos cb(boost::bind(&TransformCommRos::transformCallback, this, _1, _2, _3));
+	TransformMessageCallbackRos cb(boost::bind(&TransformCommRos::transformCallback, this, _1, _2, _3));
 	tfListener = new TransformListenerRos(cb);
+
+	aggregationWindow = conf.getAggregationWindow();
+	if (aggregationWindow > boost::posix_time::seconds(0)) {
+		aggregator = boost::thread(&TransformCommRos::aggregate, this);
+	}
 }
 void TransformCommRos::shutdown() {
 	listeners.clear();
-	std::map<std::string, boost::thread*>::iterator it;
-	for (it = legacyThreadsCache.begin(); it != legacyThreadsCache.end(); ++it) {
-		it->second->interrupt();
-		it->second->join();
-		delete it->second;
+	{
+		boost::mutex::scoped_lock lock(legacyMutex);
+		running = false;
+		legacyChanged.notify_all();
+	}
+	if (legacyRepublisher.joinable()) {
+		legacyRepublisher.join();
+	}
+	{
+		boost::mutex::scoped_lock lock(pendingMutex);
+		pendingChanged.notify_all();
+	}
+	if (aggregator.joinable()) {
+		aggregator.join();
 	}
+	flush();
 	delete tfListener;
+	tfListener = NULL;
 }
 
 bool TransformCommRos::sendTransform(const Transform& transform, TransformType type) {
@@ -70,8 +85,7 @@ bool TransformCommRos::sendTransform(const Transform& transform, TransformType t
 	if (type == STATIC) {
 		if (legacyMode) {
 			RSCDEBUG(logger, "Send transform on legacy mode broadcaster " << t);
-			bool res = sendTransformStaticLegacy(t);
-			return res;
+			return sendTransformsStaticLegacy(vector<geometry_msgs::TransformStamped>(1, t));
 		} else {
 			RSCDEBUG(logger, "Send transform on static broadcaster " << t);
 			tfBroadcasterStatic.sendTransform(t);
@@ -79,8 +93,7 @@ bool TransformCommRos::sendTransform(const Transform& transform, TransformType t
 		}
 	} else if (type == DYNAMIC) {
 		RSCDEBUG(logger, "Send transform on non-static broadcaster " << t);
-		tfBroadcaster.sendTransform(t);
-		return true;
+		return sendDynamic(vector<geometry_msgs::TransformStamped>(1, t));
 	} else {
 		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
 		return false;
@@ -88,20 +101,24 @@ bool TransformCommRos::sendTransform(const Transform& transform, TransformType t
 	return true;
 }
 
-bool TransformCommRos::sendTransformStaticLegacy(const geometry_msgs::TransformStamped& transform) {
-
-	string cacheKey = transform.header.frame_id + transform.child_frame_id;
+bool TransformCommRos::sendTransformsStaticLegacy(
+		const vector<geometry_msgs::TransformStamped>& transforms) {
 
-	ros::Duration interval(float(legacyIntervalMSec) / 1000.0);
-	if (legacyThreadsCache.count(cacheKey)) {
-		legacyThreadsCache[cacheKey]->interrupt();
-		legacyThreadsCache[cacheKey]->timed_join(boost::posix_time::seconds(2));
-		delete legacyThreadsCache[cacheKey];
+	boost::mutex::scoped_lock lock(legacyMutex);
+	if (!running) {
+		return false;
+	}
+	vector<geometry_msgs::TransformStamped>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		legacyStatics[it->child_frame_id] = *it;
 	}
 
-	legacyThreadsCache[cacheKey] = new boost::thread(
-			boost::bind(&TransformCommRos::transformLegacyPublish, this, transform, interval));
-
+	if (!legacyRepublisher.joinable()) {
+		legacyRepublisher = boost::thread(&TransformCommRos::republishLegacyStatics, this);
+	} else {
+		// publish the update now instead of at the next tick
+		legacyChanged.notify_all();
+	}
 	return true;
 }
 
@@ -114,11 +131,15 @@ bool TransformCommRos::sendTransform(const vector<Transform>& transform, Transfo
 		ts.push_back(t);
 	}
 	if (type == STATIC) {
+		if (legacyMode) {
+			RSCDEBUG(logger, "Send transform on legacy mode broadcaster " << ts);
+			return sendTransformsStaticLegacy(ts);
+		}
 		RSCDEBUG(logger, "Send transform on static broadcaster " << ts);
 		tfBroadcasterStatic.sendTransform(ts);
 	} else if (type == DYNAMIC) {
 		RSCDEBUG(logger, "Send transform on non-static broadcaster " << ts);
-		tfBroadcaster.sendTransform(ts);
+		return sendDynamic(ts);
 	} else {
 		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
 		return false;
@@ -126,62 +147,118 @@ bool TransformCommRos::sendTransform(const vector<Transform>& transform, Transfo
 	return true;
 }
 
+bool TransformCommRos::sendDynamic(const vector<geometry_msgs::TransformStamped>& transforms) {
+	if (aggregationWindow <= boost::posix_time::seconds(0) || !running) {
+		tfBroadcaster.sendTransform(transforms);
+		return true;
+	}
+
+	boost::mutex::scoped_lock lock(pendingMutex);
+	if (pending.empty()) {
+		pendingDeadline = boost::get_system_time() + aggregationWindow;
+		pendingChanged.notify_all();
+	}
+	pending.insert(pending.end(), transforms.begin(), transforms.end());
+	return true;
+}
+
+void TransformCommRos::flush() {
+	boost::mutex::scoped_lock flushLock(flushMutex);
+	vector<geometry_msgs::TransformStamped> transforms;
+	{
+		boost::mutex::scoped_lock lock(pendingMutex);
+		transforms.swap(pending);
+	}
+	if (transforms.empty()) {
+		return;
+	}
+	RSCTRACE(logger, "Send " << transforms.size() << " aggregated transforms");
+	try {
+		tfBroadcaster.sendTransform(transforms);
+	} catch (std::exception &e) {
+		RSCERROR(logger, "Cannot send transforms. Reason: " << e.what());
+	}
+}
+
+void TransformCommRos::aggregate() {
+	boost::mutex::scoped_lock lock(pendingMutex);
+	while (running) {
+		if (pending.empty()) {
+			pendingChanged.wait(lock);
+		} else if (boost::get_system_time() < pendingDeadline) {
+			pendingChanged.timed_wait(lock, pendingDeadline);
+		} else {
+			lock.unlock();
+			flush();
+			lock.lock();
+		}
+	}
+}
+
 void TransformCommRos::addTransformListener(const TransformListener::Ptr& listener) {
-	boost::mutex::scoped_lock(mutex);
-	listeners.push_back(listener);
+	listeners.add(listener);
 }
 
 void TransformCommRos::addTransformListener(const vector<TransformListener::Ptr>& l) {
-	boost::mutex::scoped_lock(mutex);
-	listeners.insert(listeners.end(), l.begin(), l.end());
+	listeners.add(l);
 }
 void TransformCommRos::removeTransformListener(const TransformListener::Ptr& listener) {
-	boost::mutex::scoped_lock(mutex);
-	vector<TransformListener::Ptr>::iterator it = find(listeners.begin(), listeners.end(),
-			listener);
-	if (it != listeners.end()) {
-		listeners.erase(it);
-	}
+	listeners.remove(listener);
 }
 
-void TransformCommRos::transformCallback(const geometry_msgs::TransformStamped rosTransform,
+void TransformCommRos::transformCallback(const tf2_msgs::TFMessage& message,
 		const std::string & authority, bool is_static) {
 
 	if (authority == ros::this_node::getName()) {
 		RSCTRACE(logger,
-				"Received transform from myself. Ignore. (authority: " << authority << ")");
+				"Received transforms from myself. Ignore. (authority: " << authority << ")");
+		return;
+	}
+	if (message.transforms.empty()) {
 		return;
 	}
 
+	// the authority is the same for the whole message
 	string authorityClean = authority;
 	boost::algorithm::replace_all(authorityClean, "/", "");
 
 	RSCTRACE(logger,
-			"Got transform from ROS. parent:" << rosTransform.header.frame_id << " child:" << rosTransform.child_frame_id << " auth:" << authorityClean);
-
-	vector<TransformListener::Ptr>::iterator it;
-	boost::mutex::scoped_lock(mutex);
-	Transform t;
-	TransformerTF2::convertTfToTransform(rosTransform, t);
-	t.setAuthority(authorityClean);
-	RSCDEBUG(logger, "Received transform: " << t);
-	for (it = listeners.begin(); it != listeners.end(); ++it) {
-		TransformListener::Ptr l = *it;
-		l->newTransformAvailable(t, is_static);
+			"Got " << message.transforms.size() << " transforms from ROS. auth:" << authorityClean);
+
+	vector<Transform> transforms(message.transforms.size());
+	for (size_t i = 0; i < message.transforms.size(); ++i) {
+		TransformerTF2::convertTfToTransform(message.transforms[i], transforms[i]);
+		transforms[i].setAuthority(authorityClean);
 	}
+	listeners.notify(transforms, is_static);
 	RSCTRACE(logger, "Notification done");
 }
 
-void TransformCommRos::transformLegacyPublish(geometry_msgs::TransformStamped t,
-		ros::Duration sleeper) {
-	while (running && !boost::this_thread::interruption_requested()) {
+void TransformCommRos::republishLegacyStatics() {
+	ros::Duration interval(float(legacyIntervalMSec) / 1000.0);
+	vector<geometry_msgs::TransformStamped> transforms;
+
+	boost::mutex::scoped_lock lock(legacyMutex);
+	while (running) {
+		// valid until the next tick
+		ros::Time stamp = ros::Time::now() + interval;
+		transforms.clear();
+		std::map<std::string, geometry_msgs::TransformStamped>::const_iterator it;
+		for (it = legacyStatics.begin(); it != legacyStatics.end(); ++it) {
+			transforms.push_back(it->second);
+			transforms.back().header.stamp = stamp;
+		}
+
+		lock.unlock();
 		try {
-			t.header.stamp = ros::Time::now() + sleeper;
-			tfBroadcaster.sendTransform(t);
-			sleeper.sleep();
+			tfBroadcaster.sendTransform(transforms);
 		} catch (std::exception &e) {
-			RSCERROR(logger, "Cannot send transform. Reason: " << e.what());
-			usleep(100 * 1000);
+			RSCERROR(logger, "Cannot send transforms. Reason: " << e.what());
+		}
+		lock.lock();
+
+		if (running) {
+			legacyChanged.timed_wait(lock, boost::posix_time::milliseconds(legacyIntervalMSec));
 		}
 	}
 }
@@ -194,6 +271,12 @@ void TransformCommRos::printContents(std::ostream& stream) const {
 	stream << "authority = " << name;
 	stream << ", communication = ros";
 	stream << ", #listeners = " << listeners.size();
+	if (legacyMode) {
+		stream << ", legacyInterval = " << legacyIntervalMSec << "ms";
+	}
+	if (aggregationWindow > boost::posix_time::seconds(0)) {
+		stream << ", aggregationWindow = " << aggregationWindow;
+	}
 }
 
 } /* namespace rct */
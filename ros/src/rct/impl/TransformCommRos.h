@@ -8,7 +8,9 @@
 #pragma once
 
 #include <rct/impl/TransformCommunicator.h>
+#include <rct/impl/TransformListenerList.h>
 #include <rct/rctConfig.h>
+#include <boost/atomic.hpp>
 
 #include <tf2_ros/transform_broadcaster.h>
 #include <tf2_ros/static_transform_broadcaster.h>
@@ -31,6 +33,9 @@ public:
 	virtual bool sendTransform(const Transform& transform, TransformType type);
 	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
 
+	/** \brief Send the dynamic transforms collected in the aggregation window now */
+	virtual void flush();
+
 	virtual void addTransformListener(const TransformListener::Ptr& listener);
 	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
 	virtual void removeTransformListener(const TransformListener::Ptr& listener);
@@ -43,19 +48,35 @@ private:
 	tf2_ros::TransformBroadcaster tfBroadcaster;
 	tf2_ros::StaticTransformBroadcaster tfBroadcasterStatic;
 
-	std::vector<TransformListener::Ptr> listeners;
-	boost::mutex mutex;
+	TransformListenerList listeners;
 	std::string name;
 
-	bool running;
+	boost::atomic<bool> running;
 	bool legacyMode;
 	long legacyIntervalMSec;
-	std::map<std::string, boost::thread*> legacyThreadsCache;
+
+	boost::mutex legacyMutex;
+	boost::condition_variable legacyChanged;
+	// latest legacy static transform per child frame, republished together
+	std::map<std::string, geometry_msgs::TransformStamped> legacyStatics;
+	boost::thread legacyRepublisher;
+
+	boost::posix_time::time_duration aggregationWindow;
+	boost::mutex pendingMutex;
+	boost::condition_variable pendingChanged;
+	// dynamic transforms waiting for the end of the aggregation window
+	std::vector<geometry_msgs::TransformStamped> pending;
+	boost::system_time pendingDeadline;
+	// keeps aggregated messages in order
+	boost::mutex flushMutex;
+	boost::thread aggregator;
 
 	static rsc::logging::LoggerPtr logger;
-	bool sendTransformStaticLegacy(const geometry_msgs::TransformStamped& transform);
-	void transformCallback(const geometry_msgs::TransformStamped transform, const std::string & authority, bool is_static);
-	void transformLegacyPublish(geometry_msgs::TransformStamped t, ros::Duration sleeper);
+	bool sendTransformsStaticLegacy(const std::vector<geometry_msgs::TransformStamped>& transforms);
+	void transformCallback(const tf2_msgs::TFMessage& message, const std::string & authority, bool is_static);
+	void republishLegacyStatics();
+	bool sendDynamic(const std::vector<geometry_msgs::TransformStamped>& transforms);
+	void aggregate();
 };
 
 } /* namespace rct */
@@ -11,6 +11,15 @@ using namespace rct;
 
 TransformListenerRos::TransformListenerRos(TransformCallbackRos& cb) :
 		clientCallback(cb) {
+	subscribe();
+}
+
+TransformListenerRos::TransformListenerRos(TransformMessageCallbackRos& cb) :
+		messageCallback(cb) {
+	subscribe();
+}
+
+void TransformListenerRos::subscribe() {
 	ros::SubscribeOptions ops;
 	ops.template initByFullCallbackType<const ros::MessageEvent<tf2_msgs::TFMessage const>&>("/tf",
 			1000, boost::bind(&TransformListenerRos::subscriptionCallback, this, _1));
@@ -40,6 +49,10 @@ void TransformListenerRos::subscriptionCallbackImpl(
 
 	const tf2_msgs::TFMessage& msg_in = *(msg_evt.getConstMessage());
 	std::string authority = msg_evt.getPublisherName(); // lookup the authority
+	if (messageCallback) {
+		messageCallback(msg_in, authority, is_static);
+		return;
+	}
 	for (unsigned int i = 0; i < msg_in.transforms.size(); i++) {
 		clientCallback(msg_in.transforms[i], authority, is_static);
 	}
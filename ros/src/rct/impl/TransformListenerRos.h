@@ -19,9 +19,13 @@ namespace rct {
 
 typedef boost::function<void(const geometry_msgs::TransformStamped transform, const std::string & authority, bool is_static)> TransformCallbackRos;
 
+/** Receives all transforms of a message at once, the authority is the same for all of them. */
+typedef boost::function<void(const tf2_msgs::TFMessage& message, const std::string & authority, bool is_static)> TransformMessageCallbackRos;
+
 class TransformListenerRos {
 public:
 	TransformListenerRos(TransformCallbackRos& cb);
+	TransformListenerRos(TransformMessageCallbackRos& cb);
 	~TransformListenerRos();
 
 private:
@@ -29,8 +33,10 @@ private:
   void subscriptionCallback(const ros::MessageEvent<tf2_msgs::TFMessage const>& msg_evt);
   void staticSubscriptionCallback(const ros::MessageEvent<tf2_msgs::TFMessage const>& msg_evt);
   void subscriptionCallbackImpl(const ros::MessageEvent<tf2_msgs::TFMessage const>& msg_evt, bool is_static);
+  void subscribe();
 
   TransformCallbackRos clientCallback;
+  TransformMessageCallbackRos messageCallback;
   ros::NodeHandle node;
   ros::Subscriber subscriberTf;
   ros::Subscriber subscriberTfStatic;
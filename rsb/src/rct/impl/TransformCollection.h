@@ -0,0 +1,45 @@
+/*
+ * TransformCollection.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Several transforms sent as a single event, see
+ * rct.proto.FrameTransformCollection.
+ *
+ * If ids are given, frame and authority names are referenced by ids of the
+ * sender's NameDictionary and the frame names of the transforms are not
+ * sent. Entries not announced yet travel with the collection, starting at
+ * dictionaryOffset.
+ */
+class TransformCollection {
+public:
+	TransformCollection() :
+			transforms(new std::vector<Transform>()), hasIds(false), authority(0), dictionaryOffset(
+					0) {
+	}
+
+	boost::shared_ptr<std::vector<Transform> > transforms;
+
+	bool hasIds;
+	std::vector<boost::uint32_t> parents;
+	std::vector<boost::uint32_t> children;
+	boost::uint32_t authority;
+
+	boost::uint32_t dictionaryOffset;
+	std::vector<std::string> dictionary;
+};
+
+} /* namespace rct */
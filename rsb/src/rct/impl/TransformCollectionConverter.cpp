@@ -0,0 +1,135 @@
+/*
+ * TransformCollectionConverter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformCollectionConverter.h"
+#include "TransformConverter.h"
+#include "TransformCollection.h"
+#include <rct/Transform.h>
+
+#include <rsb/converter/SerializationException.h>
+#include <rsb/converter/ProtocolBufferConverter.h>
+
+#include <boost/thread/tss.hpp>
+
+#include <openbase/type/geometry/FrameTransform.pb.h>
+#include <FrameTransformCollection.pb.h>
+
+using namespace std;
+using namespace boost;
+using namespace rsb;
+using namespace rsb::converter;
+using namespace openbase::type::geometry;
+
+namespace rct {
+
+// protobuf message reused by every conversion running on the same thread
+static boost::thread_specific_ptr<rct::proto::FrameTransformCollection> collectionProto;
+
+static const size_t poolCapacity = 256;
+
+TransformCollectionConverter::TransformCollectionConverter():
+                rsb::converter::Converter<string>(
+                        rsc::runtime::typeName<rct::proto::FrameTransformCollection>(),
+                        RSB_TYPE_TAG(TransformCollection)) {
+	converter = boost::shared_ptr<Converter<string> >(new ProtocolBufferConverter<rct::proto::FrameTransformCollection>);
+	pool = TransformCollectionPool::Ptr(new TransformCollectionPool(poolCapacity));
+}
+
+TransformCollectionConverter::~TransformCollectionConverter() {
+}
+
+std::string TransformCollectionConverter::getWireSchema() const {
+	return converter->getWireSchema();
+}
+
+std::string TransformCollectionConverter::serialize(const rsb::AnnotatedData& data, std::string& wire) {
+	// Cast to original domain type
+	boost::shared_ptr<TransformCollection> domain = static_pointer_cast<TransformCollection>(data.second);
+
+	if (!collectionProto.get()) {
+		collectionProto.reset(new rct::proto::FrameTransformCollection());
+	}
+
+	// Fill the thread's protocol buffer object. Clear() keeps the elements
+	// allocated for the next message, so the collection is serialized in a
+	// single pass.
+	rct::proto::FrameTransformCollection& proto = *collectionProto;
+	proto.Clear();
+	const vector<Transform>& transforms = *domain->transforms;
+	for (size_t i = 0; i < transforms.size(); ++i) {
+		FrameTransform* element = proto.add_element();
+		TransformConverter::domainToRST(transforms[i], *element);
+		if (domain->hasIds) {
+			// the names are referenced by the ids
+			element->mutable_frame_parent()->clear();
+			element->mutable_frame_child()->clear();
+			proto.add_parent(domain->parents[i]);
+			proto.add_child(domain->children[i]);
+		}
+	}
+	if (domain->hasIds) {
+		proto.set_authority(domain->authority);
+	}
+	if (!domain->dictionary.empty()) {
+		proto.set_dictionary_offset(domain->dictionaryOffset);
+		vector<string>::const_iterator it;
+		for (it = domain->dictionary.begin(); it != domain->dictionary.end(); ++it) {
+			proto.add_dictionary(*it);
+		}
+	}
+
+	if (!proto.SerializeToString(&wire)) {
+		throw SerializationException("Failed to serialize FrameTransformCollection");
+	}
+	return getWireSchema();
+}
+
+rsb::AnnotatedData TransformCollectionConverter::deserialize(const std::string& wireType,
+		const std::string& wire) {
+
+	if (wireType != getWireSchema()) {
+		throw SerializationException("Unexpected wire schema " + wireType);
+	}
+
+	if (!collectionProto.get()) {
+		collectionProto.reset(new rct::proto::FrameTransformCollection());
+	}
+
+	rct::proto::FrameTransformCollection& proto = *collectionProto;
+	if (!proto.ParseFromString(wire)) {
+		throw SerializationException("Failed to parse FrameTransformCollection");
+	}
+	bool hasIds = proto.parent_size() > 0 || proto.child_size() > 0;
+	if (hasIds && (proto.parent_size() != proto.element_size()
+			|| proto.child_size() != proto.element_size())) {
+		throw SerializationException("Frame ids do not match the elements of FrameTransformCollection");
+	}
+
+	// Domain objects return to the pool when the last reference to the event
+	// data is released. The vector keeps its capacity and the elements their
+	// frame name strings, so handlers must copy the transforms they keep
+	// instead of sharing the vector.
+	boost::shared_ptr<TransformCollection> domain = pool->acquire();
+	vector<Transform>& transforms = *domain->transforms;
+	transforms.resize(proto.element_size());
+
+	// Read domain data from ProtoBuf
+	for (int i = 0; i < proto.element_size(); ++i) {
+		transforms[i].setAuthority("");
+		TransformConverter::rstToDomain(proto.element(i), transforms[i]);
+	}
+	domain->hasIds = hasIds;
+	domain->parents.assign(proto.parent().begin(), proto.parent().end());
+	domain->children.assign(proto.child().begin(), proto.child().end());
+	domain->authority = proto.authority();
+	domain->dictionaryOffset = proto.dictionary_offset();
+	domain->dictionary.assign(proto.dictionary().begin(), proto.dictionary().end());
+
+	return rsb::AnnotatedData(getDataType(), domain);
+}
+
+} /* namespace rct */
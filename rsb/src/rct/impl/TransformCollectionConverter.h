@@ -0,0 +1,45 @@
+/*
+ * TransformCollectionConverter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include <rsb/converter/Converter.h>
+#include "TransformPool.h"
+#include "TransformCollection.h"
+
+namespace rct {
+
+typedef RecyclingPool<TransformCollection> TransformCollectionPool;
+
+/**
+ * Converts a TransformCollection into a single
+ * rct.proto.FrameTransformCollection and back.
+ */
+class TransformCollectionConverter: public rsb::converter::Converter<std::string>  {
+public:
+	typedef boost::shared_ptr<TransformCollectionConverter> Ptr;
+
+	TransformCollectionConverter();
+	virtual ~TransformCollectionConverter();
+
+    std::string getWireSchema() const;
+
+    std::string serialize(const rsb::AnnotatedData &data, std::string &wire);
+    rsb::AnnotatedData deserialize(const std::string &wireType,
+            const std::string &wire);
+
+private:
+
+    boost::shared_ptr<rsb::converter::Converter<std::string> > converter;
+    TransformCollectionPool::Ptr pool;
+};
+
+} /* namespace rct */
@@ -7,7 +7,11 @@
 
 #include "TransformCommRsb.h"
 #include "TransformConverter.h"
+#include "TransformCollectionConverter.h"
+#include "TransformCollection.h"
+#include <rct/impl/TransformCommLoopback.h>
 #include <rsb/converter/Repository.h>
+#include <rsb/converter/ProtocolBufferConverter.h>
 #include <rsb/Factory.h>
 #include <rsb/Handler.h>
 #include <rsb/Event.h>
@@ -15,6 +19,8 @@
 #include <rsc/runtime/TypeStringTools.h>
 #include <log4cxx/log4cxx.h>
 #include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
+#include <CompactTransformCollection.pb.h>
 
 using namespace std;
 using namespace rsb;
@@ -28,6 +34,19 @@ string TransformCommRsb::defaultScopeTransforms = "/rct/transform";
 string TransformCommRsb::defaultScopeSufficStatic = "/static";
 string TransformCommRsb::defaultScopeSuffixDynamic = "/dynamic";
 string TransformCommRsb::defaultUserKeyAuthority = "authority";
+string TransformCommRsb::userKeyOrigin = "origin";
+string TransformCommRsb::userKeySequence = "sequence";
+string TransformCommRsb::userKeySnapshot = "snapshot";
+string TransformCommRsb::userKeySyncOrigin = "sync.origin";
+string TransformCommRsb::userKeySyncMode = "sync.mode";
+string TransformCommRsb::userKeySyncFrom = "sync.from";
+string TransformCommRsb::userKeySyncTo = "sync.to";
+string TransformCommRsb::userKeyProcess = "process";
+
+// more missing ranges than this are requested as a full sync of the origin
+static const size_t maxRangesPerOrigin = 16;
+// state of origins not heard of for this long is dropped
+static const boost::posix_time::time_duration originTimeout = boost::posix_time::minutes(10);
 
 TransformCommRsb::TransformCommRsb(const string &authority) :
 		authority(authority),
@@ -35,7 +54,16 @@ TransformCommRsb::TransformCommRsb(const string &authority) :
 		scopeTransforms(defaultScopeTransforms),
 		scopeSuffixStatic(defaultScopeSufficStatic),
 		scopeSuffixDynamic(defaultScopeSuffixDynamic),
-		userKeyAuthority(defaultUserKeyAuthority) {
+		userKeyAuthority(defaultUserKeyAuthority),
+		syncPending(false),
+		dictionaryPending(false),
+		syncRunning(false),
+		syncBatchSize(0),
+		staticSyncPending(false),
+		gapCheckPending(false),
+		sequence(0),
+		historySize(0),
+		dictionaryAnnounced(0) {
 }
 
 TransformCommRsb::TransformCommRsb(const string &authority, const TransformListener::Ptr& l) :
@@ -44,7 +72,16 @@ TransformCommRsb::TransformCommRsb(const string &authority, const TransformListe
 		scopeTransforms(defaultScopeTransforms),
 		scopeSuffixStatic(defaultScopeSufficStatic),
 		scopeSuffixDynamic(defaultScopeSuffixDynamic),
-		userKeyAuthority(defaultUserKeyAuthority) {
+		userKeyAuthority(defaultUserKeyAuthority),
+		syncPending(false),
+		dictionaryPending(false),
+		syncRunning(false),
+		syncBatchSize(0),
+		staticSyncPending(false),
+		gapCheckPending(false),
+		sequence(0),
+		historySize(0),
+		dictionaryAnnounced(0) {
 
 	addTransformListener(l);
 }
@@ -55,7 +92,16 @@ TransformCommRsb::TransformCommRsb(const string &authority, const vector<Transfo
 		scopeTransforms(defaultScopeTransforms),
 		scopeSuffixStatic(defaultScopeSufficStatic),
 		scopeSuffixDynamic(defaultScopeSuffixDynamic),
-		userKeyAuthority(defaultUserKeyAuthority) {
+		userKeyAuthority(defaultUserKeyAuthority),
+		syncPending(false),
+		dictionaryPending(false),
+		syncRunning(false),
+		syncBatchSize(0),
+		staticSyncPending(false),
+		gapCheckPending(false),
+		sequence(0),
+		historySize(0),
+		dictionaryAnnounced(0) {
 
 	addTransformListener(l);
 }
@@ -68,7 +114,16 @@ TransformCommRsb::TransformCommRsb(const string &authority, const TransformListe
 		scopeTransforms(scopeTransforms),
 		scopeSuffixStatic(scopeSuffixStatic),
 		scopeSuffixDynamic(scopeSuffixDynamic),
-		userKeyAuthority(userKeyAuthority) {
+		userKeyAuthority(userKeyAuthority),
+		syncPending(false),
+		dictionaryPending(false),
+		syncRunning(false),
+		syncBatchSize(0),
+		staticSyncPending(false),
+		gapCheckPending(false),
+		sequence(0),
+		historySize(0),
+		dictionaryAnnounced(0) {
 
 	addTransformListener(l);
 }
@@ -81,12 +136,22 @@ TransformCommRsb::TransformCommRsb(const string &authority, const vector<Transfo
 		scopeTransforms(scopeTransforms),
 		scopeSuffixStatic(scopeSuffixStatic),
 		scopeSuffixDynamic(scopeSuffixDynamic),
-		userKeyAuthority(userKeyAuthority) {
+		userKeyAuthority(userKeyAuthority),
+		syncPending(false),
+		dictionaryPending(false),
+		syncRunning(false),
+		syncBatchSize(0),
+		staticSyncPending(false),
+		gapCheckPending(false),
+		sequence(0),
+		historySize(0),
+		dictionaryAnnounced(0) {
 
 	addTransformListener(l);
 }
 
 TransformCommRsb::~TransformCommRsb() {
+	stopSyncResponder();
 }
 
 void TransformCommRsb::init(const TransformerConfig &conf) {
@@ -98,29 +163,65 @@ void TransformCommRsb::init(const TransformerConfig &conf) {
 	} catch (std::invalid_argument &e) {
 		RSCTRACE(logger, "Converter already present");
 	}
+	try {
+		TransformCollectionConverter::Ptr converter1(new TransformCollectionConverter());
+		converter::converterRepository<string>()->registerConverter(converter1);
+	} catch (std::invalid_argument &e) {
+		RSCTRACE(logger, "Collection converter already present");
+	}
+	try {
+		boost::shared_ptr<converter::ProtocolBufferConverter<proto::CompactTransformCollection> > converter2(
+				new converter::ProtocolBufferConverter<proto::CompactTransformCollection>());
+		converter::converterRepository<string>()->registerConverter(converter2);
+	} catch (std::invalid_argument &e) {
+		RSCTRACE(logger, "Compact converter already present");
+	}
 
 	Factory &factory = rsb::getFactory();
 
 	rsbListenerTransform = factory.createListener(scopeTransforms);
 	rsbListenerSync = factory.createListener(scopeSync);
 	rsbInformerTransform = factory.createInformer<Transform>(scopeTransforms);
+	if (conf.isBatchingEnabled()) {
+		rsbInformerTransformCollection = factory.createInformer<TransformCollection>(scopeTransforms);
+	}
+	if (conf.getEncoding() == TransformerConfig::ENCODING_COMPACT) {
+		rsbInformerCompact = factory.createInformer<proto::CompactTransformCollection>(scopeTransforms);
+		quantizer = boost::make_shared<TransformQuantizer>(conf.getTranslationResolution(),
+				conf.getRotationResolution(), conf.getKeyframeInterval());
+	}
 	rsbInformerSync = factory.createInformer<void>(scopeSync);
+	origin = rsbInformerTransform->getId().getIdAsString();
 
 	EventFunction f0(bind(&TransformCommRsb::transformCallback, this, _1));
 	transformHandler = HandlerPtr(new EventFunctionHandler(f0));
 	rsbListenerTransform->addHandler(transformHandler);
 
+	syncWindow = conf.getSyncWindow();
+	syncBatchSize = std::max<size_t>(1, conf.getSyncBatchSize());
+	historySize = conf.getResendHistory();
+	if (conf.isLoopbackEnabled()) {
+		process = TransformCommLoopback::getProcessId();
+	}
+	syncRunning = true;
+	syncResponder = boost::thread(&TransformCommRsb::respondToSyncRequests, this);
+
 	EventFunction f1(bind(&TransformCommRsb::triggerCallback, this, _1));
 	syncHandler = HandlerPtr(new EventFunctionHandler(f1));
 	rsbListenerSync->addHandler(syncHandler);
 
-	requestSync();
+	if (conf.isStaticInitialSync()) {
+		requestStaticSync();
+	} else {
+		requestSync();
+	}
 
 }
 void TransformCommRsb::shutdown() {
 	listeners.clear();
 	rsbListenerTransform->removeHandler(transformHandler);
-	rsbListenerTransform->removeHandler(syncHandler);
+	rsbListenerSync->removeHandler(syncHandler);
+	stopSyncResponder();
 }
 void TransformCommRsb::requestSync() {
 
@@ -135,39 +236,72 @@ void TransformCommRsb::requestSync() {
 	rsbInformerSync->publish(boost::shared_ptr<void>());
 }
 
+void TransformCommRsb::requestStaticSync() {
+
+	if (!rsbInformerSync) {
+		throw std::runtime_error("communicator was not initialized!");
+	}
+
+	RSCDEBUG(logger,
+			"Sending static sync request trigger from id " << rsbInformerSync->getId().getIdAsString());
+
+	// peers not knowing the mode answer with a full sync
+	MetaData meta;
+	meta.setUserInfo(userKeySyncMode, "static");
+	publishSyncRequest(meta);
+}
+
+void TransformCommRsb::publishSyncRequest(const MetaData& meta) {
+	EventPtr event(rsbInformerSync->createEvent());
+	event->setMetaData(meta);
+	rsbInformerSync->publish(event);
+}
+
 bool TransformCommRsb::sendTransform(const Transform& transform, TransformType type) {
 	if (!rsbInformerTransform) {
 		throw std::runtime_error("communicator was not initialized!");
 	}
 
+	if (type == DYNAMIC && quantizer) {
+		return sendCompact(std::vector<Transform>(1, transform));
+	}
+
 	const string cacheKey = transform.getFrameParent() + transform.getFrameChild();
 
 	RSCTRACE(logger, "sendTransform() ");
 
+	string transformAuthority = transform.getAuthority() == "" ? authority : transform.getAuthority();
 	MetaData meta;
-	if (transform.getAuthority() == "") {
-		meta.setUserInfo(userKeyAuthority, authority);
-	} else {
-		meta.setUserInfo(userKeyAuthority, transform.getAuthority());
-	}
+	meta.setUserInfo(userKeyAuthority, transformAuthority);
 
-	boost::mutex::scoped_lock(mutex);
 	RSCTRACE(logger,
 			"Publishing transform from " << rsbInformerTransform->getId().getIdAsString());
 	EventPtr event(rsbInformerTransform->createEvent());
 	event->setData(boost::make_shared<Transform>(transform));
-	event->setMetaData(meta);
 
 	if (type == STATIC) {
-		sendCacheStatic[cacheKey] = make_pair(transform, meta);
 		event->setScope(rsbInformerTransform->getScope()->concat(Scope(scopeSuffixStatic)));
 	} else if (type == DYNAMIC) {
-		sendCacheDynamic[cacheKey] = make_pair(transform, meta);
 		event->setScope(rsbInformerTransform->getScope()->concat(Scope(scopeSuffixDynamic)));
 	} else {
 		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
 		return false;
 	}
+
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (type == STATIC) {
+			sendCacheStatic[cacheKey] = make_pair(transform, meta);
+		} else {
+			sendCacheDynamic[cacheKey] = make_pair(transform, meta);
+		}
+		sequence++;
+		if (historySize > 0) {
+			remember(sequence, boost::make_shared<std::vector<Transform> >(1, transform),
+					transformAuthority, type == STATIC);
+		}
+		event->setMetaData(withSequence(meta, userKeySequence, sequence));
+	}
 	RSCTRACE(logger, "sending " << event->getScope() << " " << transform);
 	rsbInformerTransform->publish(event);
 	RSCTRACE(logger, "sendTransform() done");
@@ -175,74 +309,867 @@ bool TransformCommRsb::sendTransform(const Transform& transform, TransformType t
 }
 
 bool TransformCommRsb::sendTransform(const std::vector<Transform>& transforms, TransformType type) {
-	std::vector<Transform>::const_iterator it;
-	for (it = transforms.begin(); it != transforms.end(); ++it) {
-		sendTransform(*it, type);
+	if (type == DYNAMIC && quantizer) {
+		return sendCompact(transforms);
+	}
+	if (!rsbInformerTransformCollection) {
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			sendTransform(*it, type);
+		}
+		return true;
+	}
+
+	Scope scope;
+	if (type == STATIC) {
+		scope = rsbInformerTransformCollection->getScope()->concat(Scope(scopeSuffixStatic));
+	} else if (type == DYNAMIC) {
+		scope = rsbInformerTransformCollection->getScope()->concat(Scope(scopeSuffixDynamic));
+	} else {
+		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
+		return false;
+	}
+
+	// the authority is attached per event, so group by authority. Usually
+	// all transforms share the same one.
+	map<string, boost::shared_ptr<std::vector<Transform> > > collections;
+	map<string, MetaData> metas;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			string transformAuthority = it->getAuthority() == "" ? authority : it->getAuthority();
+			MetaData meta;
+			meta.setUserInfo(userKeyAuthority, transformAuthority);
+
+			const string cacheKey = it->getFrameParent() + it->getFrameChild();
+			if (type == STATIC) {
+				sendCacheStatic[cacheKey] = make_pair(*it, meta);
+			} else {
+				sendCacheDynamic[cacheKey] = make_pair(*it, meta);
+			}
+
+			boost::shared_ptr<std::vector<Transform> >& collection = collections[transformAuthority];
+			if (!collection) {
+				collection = boost::make_shared<std::vector<Transform> >();
+			}
+			collection->push_back(*it);
+		}
+
+		map<string, boost::shared_ptr<std::vector<Transform> > >::iterator collectionIt;
+		for (collectionIt = collections.begin(); collectionIt != collections.end(); ++collectionIt) {
+			sequence++;
+			if (historySize > 0) {
+				remember(sequence, collectionIt->second, collectionIt->first, type == STATIC);
+			}
+			// the authority is part of the collection
+			metas[collectionIt->first] = withSequence(MetaData(), userKeySequence, sequence);
+		}
+	}
+
+	map<string, boost::shared_ptr<std::vector<Transform> > >::iterator it;
+	for (it = collections.begin(); it != collections.end(); ++it) {
+		publishCollection(it->second, it->first, metas[it->first], scope);
 	}
 	return true;
 }
 
-void TransformCommRsb::publishCache() {
+bool TransformCommRsb::sendCompact(const std::vector<Transform>& transforms) {
+	if (transforms.empty()) {
+		return true;
+	}
+	Scope scope = rsbInformerCompact->getScope()->concat(Scope(scopeSuffixDynamic));
+
+	map<string, boost::shared_ptr<proto::CompactTransformCollection> > collections;
+	map<string, boost::shared_ptr<std::vector<Transform> > > plain;
+	map<string, MetaData> metas;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		QuantizedTransform sample;
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms.begin(); it != transforms.end(); ++it) {
+			string transformAuthority = it->getAuthority() == "" ? authority : it->getAuthority();
+			MetaData meta;
+			meta.setUserInfo(userKeyAuthority, transformAuthority);
+			sendCacheDynamic[it->getFrameParent() + it->getFrameChild()] = make_pair(*it, meta);
+
+			boost::shared_ptr<proto::CompactTransformCollection>& collection =
+					collections[transformAuthority];
+			if (!collection) {
+				collection = boost::make_shared<proto::CompactTransformCollection>();
+				collection->set_translation_resolution(quantizer->getTranslationResolution());
+				collection->set_rotation_resolution(quantizer->getRotationResolution());
+				collection->set_authority(dictionary.encode(transformAuthority));
+			}
+			if (historySize > 0) {
+				boost::shared_ptr<std::vector<Transform> >& sent = plain[transformAuthority];
+				if (!sent) {
+					sent = boost::make_shared<std::vector<Transform> >();
+				}
+				sent->push_back(*it);
+			}
+
+			quantizer->encode(*it, sample);
+			proto::CompactTransform* element = collection->add_transform();
+			element->set_edge(sample.edge);
+			element->set_index(sample.index);
+			element->set_keyframe(sample.keyframe);
+			if (sample.keyframe) {
+				element->set_parent(dictionary.encode(sample.parent));
+				element->set_child(dictionary.encode(sample.child));
+			}
+			element->set_time(sample.time);
+			for (int i = 0; i < 7; ++i) {
+				element->add_value(sample.values[i]);
+			}
+		}
+
+		// entries not announced yet travel with the first collection
+		if (dictionaryAnnounced < dictionary.size()) {
+			proto::CompactTransformCollection& first = *collections.begin()->second;
+			first.set_dictionary_offset(dictionaryAnnounced);
+			for (size_t id = dictionaryAnnounced; id < dictionary.size(); ++id) {
+				first.add_dictionary(dictionary.getName(id));
+			}
+			dictionaryAnnounced = dictionary.size();
+		}
+
+		// the history keeps the plain transforms, resends use the default encoding
+		map<string, boost::shared_ptr<proto::CompactTransformCollection> >::iterator collectionIt;
+		for (collectionIt = collections.begin(); collectionIt != collections.end(); ++collectionIt) {
+			sequence++;
+			if (historySize > 0) {
+				remember(sequence, plain[collectionIt->first], collectionIt->first, false);
+			}
+			// the authority is part of the collection
+			metas[collectionIt->first] = withSequence(MetaData(), userKeySequence, sequence);
+		}
+	}
+
+	map<string, boost::shared_ptr<proto::CompactTransformCollection> >::iterator it;
+	for (it = collections.begin(); it != collections.end(); ++it) {
+		EventPtr event(rsbInformerCompact->createEvent());
+		event->setData(it->second);
+		event->setMetaData(metas[it->first]);
+		event->setScope(scope);
+		RSCTRACE(logger, "sending " << it->second->transform_size() << " compact transforms");
+		rsbInformerCompact->publish(event);
+	}
+	return true;
+}
+
+void TransformCommRsb::decodeCompact(const EventPtr& event, std::vector<Transform>& transforms) {
+	boost::shared_ptr<proto::CompactTransformCollection> collection = boost::static_pointer_cast<
+			proto::CompactTransformCollection>(event->getData());
+	const string origin = getOrigin(event->getMetaData());
+
+	bool requestDictionary = false;
+	bool requestKeyframes = false;
+	{
+		boost::mutex::scoped_lock lock(decodeMutex);
+		Decoder& decoder = getDecoder(origin);
+
+		try {
+			if (collection->has_dictionary_offset() && collection->dictionary_offset() == 0) {
+				// complete announcement, the sender may have restarted
+				decoder.dictionary.clear();
+			}
+			for (int i = 0; i < collection->dictionary_size(); ++i) {
+				decoder.dictionary.define(collection->dictionary_offset() + i,
+						collection->dictionary(i));
+			}
+		} catch (std::out_of_range &e) {
+			RSCWARN(logger, "Ignoring invalid dictionary of " << origin);
+			return;
+		}
+
+		string transformAuthority;
+		if (!decoder.dictionary.decode(collection->authority(), transformAuthority)) {
+			requestDictionary = true;
+		}
+
+		transforms.reserve(collection->transform_size());
+		QuantizedTransform sample;
+		Transform transform;
+		transform.setAuthority(transformAuthority);
+		for (int i = 0; i < collection->transform_size() && !requestDictionary; ++i) {
+			const proto::CompactTransform& element = collection->transform(i);
+			if (element.value_size() != 7) {
+				RSCWARN(logger,
+						"Ignoring compact transform with " << element.value_size() << " values");
+				continue;
+			}
+			sample.edge = element.edge();
+			sample.index = element.index();
+			sample.keyframe = element.keyframe();
+			if (sample.keyframe
+					&& (!decoder.dictionary.decode(element.parent(), sample.parent)
+							|| !decoder.dictionary.decode(element.child(), sample.child))) {
+				requestDictionary = true;
+				break;
+			}
+			sample.time = element.time();
+			for (int v = 0; v < 7; ++v) {
+				sample.values[v] = element.value(v);
+			}
+			if (decoder.dequantizer.decode(sample, collection->translation_resolution(),
+					collection->rotation_resolution(), transform)) {
+				transforms.push_back(transform);
+			} else {
+				RSCTRACE(logger, "Skipping compact transform of edge " << sample.edge
+						<< " until the next keyframe");
+				requestKeyframes = true;
+			}
+		}
+		if (requestDictionary) {
+			dictionaryRequests.insert(origin);
+		}
+		if (requestKeyframes) {
+			keyframeRequests.insert(origin);
+		}
+	}
+
+	if (requestDictionary || requestKeyframes) {
+		RSCDEBUG(logger, "Cannot decode message of " << origin << " completely");
+		{
+			boost::mutex::scoped_lock lock(syncMutex);
+			gapCheckPending = true;
+		}
+		syncCondition.notify_one();
+	}
+}
+
+bool TransformCommRsb::decodeNames(const EventPtr& event, TransformCollection& collection) {
+	const string origin = getOrigin(event->getMetaData());
+	std::vector<Transform>& transforms = *collection.transforms;
+	{
+		boost::mutex::scoped_lock lock(decodeMutex);
+		Decoder& decoder = getDecoder(origin);
+
+		try {
+			if (!collection.dictionary.empty() && collection.dictionaryOffset == 0) {
+				// complete announcement, the sender may have restarted
+				decoder.dictionary.clear();
+			}
+			for (size_t i = 0; i < collection.dictionary.size(); ++i) {
+				decoder.dictionary.define(collection.dictionaryOffset + i, collection.dictionary[i]);
+			}
+		} catch (std::out_of_range &e) {
+			RSCWARN(logger, "Ignoring invalid dictionary of " << origin);
+			return false;
+		}
+
+		string transformAuthority;
+		string parent;
+		string child;
+		bool complete = decoder.dictionary.decode(collection.authority, transformAuthority);
+		for (size_t i = 0; i < transforms.size() && complete; ++i) {
+			complete = decoder.dictionary.decode(collection.parents[i], parent)
+					&& decoder.dictionary.decode(collection.children[i], child);
+			transforms[i].setFrameParent(parent);
+			transforms[i].setFrameChild(child);
+			transforms[i].setAuthority(transformAuthority);
+		}
+		if (complete) {
+			return true;
+		}
+		dictionaryRequests.insert(origin);
+	}
+
+	RSCDEBUG(logger, "Unknown dictionary id in message of " << origin);
+	{
+		boost::mutex::scoped_lock lock(syncMutex);
+		gapCheckPending = true;
+	}
+	syncCondition.notify_one();
+	return false;
+}
+
+// requires decodeMutex
+TransformCommRsb::Decoder& TransformCommRsb::getDecoder(const string& origin) {
+	const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+	map<string, Decoder>::iterator decoderIt = decoders.find(origin);
+	if (decoderIt == decoders.end()) {
+		// a new sender starts with an empty decoder, forget those gone silent
+		map<string, Decoder>::iterator it = decoders.begin();
+		while (it != decoders.end()) {
+			if (now - it->second.lastReceived > originTimeout) {
+				decoders.erase(it++);
+			} else {
+				++it;
+			}
+		}
+		decoderIt = decoders.insert(make_pair(origin, Decoder())).first;
+	}
+	decoderIt->second.lastReceived = now;
+	return decoderIt->second;
+}
+
+string TransformCommRsb::getOrigin(const MetaData& meta) const {
+	return meta.hasUserInfo(userKeyOrigin) ?
+			meta.getUserInfo(userKeyOrigin) : meta.getSenderId().getIdAsString();
+}
+
+void TransformCommRsb::remember(boost::uint64_t sequence,
+		const boost::shared_ptr<std::vector<Transform> >& transforms, const string& authority,
+		bool isStatic) {
+	SentMessage message;
+	message.sequence = sequence;
+	message.transforms = transforms;
+	message.authority = authority;
+	message.isStatic = isStatic;
+	history.push_back(message);
+	while (history.size() > historySize) {
+		history.pop_front();
+	}
+}
+
+MetaData TransformCommRsb::withSequence(const MetaData& meta, const string& key,
+		boost::uint64_t value) const {
+	MetaData result(meta);
+	result.setUserInfo(userKeyOrigin, origin);
+	result.setUserInfo(key, boost::lexical_cast<string>(value));
+	if (!process.empty()) {
+		result.setUserInfo(userKeyProcess, process);
+	}
+	return result;
+}
+
+void TransformCommRsb::publishCollection(const boost::shared_ptr<std::vector<Transform> >& transforms,
+		const string& transformAuthority, const MetaData& meta, const Scope& scope) {
+	boost::shared_ptr<TransformCollection> collection = boost::make_shared<TransformCollection>();
+	collection->transforms = transforms;
+	collection->hasIds = true;
+	collection->parents.reserve(transforms->size());
+	collection->children.reserve(transforms->size());
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		collection->authority = dictionary.encode(transformAuthority);
+		std::vector<Transform>::const_iterator it;
+		for (it = transforms->begin(); it != transforms->end(); ++it) {
+			collection->parents.push_back(dictionary.encode(it->getFrameParent()));
+			collection->children.push_back(dictionary.encode(it->getFrameChild()));
+		}
+		// entries not announced yet travel with this collection
+		if (dictionaryAnnounced < dictionary.size()) {
+			collection->dictionaryOffset = dictionaryAnnounced;
+			for (size_t id = dictionaryAnnounced; id < dictionary.size(); ++id) {
+				collection->dictionary.push_back(dictionary.getName(id));
+			}
+			dictionaryAnnounced = dictionary.size();
+		}
+	}
+
+	// the ids are only meaningful together with the origin
+	MetaData collectionMeta(meta);
+	collectionMeta.setUserInfo(userKeyOrigin, origin);
+
+	EventPtr event(rsbInformerTransformCollection->createEvent());
+	event->setData(collection);
+	event->setMetaData(collectionMeta);
+	event->setScope(scope);
+	RSCTRACE(logger, "sending " << transforms->size() << " transforms on " << scope);
+	rsbInformerTransformCollection->publish(event);
+}
+
+void TransformCommRsb::respondToSyncRequests() {
+	boost::mutex::scoped_lock lock(syncMutex);
+	while (syncRunning) {
+		if (!syncPending && !staticSyncPending && !dictionaryPending && !gapCheckPending
+				&& resendRequests.empty()) {
+			syncCondition.wait(lock);
+			continue;
+		}
+
+		// coalesce all requests arriving within the window into one answer
+		boost::system_time deadline = boost::get_system_time() + syncWindow;
+		while (syncRunning && syncCondition.timed_wait(lock, deadline)) {
+		}
+		if (!syncRunning) {
+			break;
+		}
+		bool full = syncPending;
+		bool staticOnly = staticSyncPending;
+		bool announce = dictionaryPending;
+		bool checkGaps = gapCheckPending;
+		std::vector<std::pair<boost::uint64_t, boost::uint64_t> > ranges;
+		ranges.swap(resendRequests);
+		syncPending = false;
+		staticSyncPending = false;
+		dictionaryPending = false;
+		gapCheckPending = false;
+
+		lock.unlock();
+		try {
+			// before resent messages, which may reference the entries
+			if (announce && !full) {
+				publishDictionary();
+			}
+			if (full) {
+				publishCache(true);
+			} else {
+				if (staticOnly) {
+					publishCache(false);
+				}
+				if (!ranges.empty() && !resend(ranges)) {
+					RSCDEBUG(logger, "Requested range is not in the history anymore. Publishing cache.");
+					publishCache(true);
+				}
+			}
+			if (checkGaps) {
+				requestMissing();
+			}
+		} catch (std::exception &e) {
+			RSCERROR(logger, "Cannot answer sync request. Reason: " << e.what());
+		}
+		lock.lock();
+	}
+}
+
+void TransformCommRsb::stopSyncResponder() {
+	{
+		boost::mutex::scoped_lock lock(syncMutex);
+		syncRunning = false;
+	}
+	syncCondition.notify_all();
+	if (syncResponder.joinable() && syncResponder.get_id() != boost::this_thread::get_id()) {
+		syncResponder.join();
+	}
+}
+
+void TransformCommRsb::publishCache(bool includeDynamic) {
 	RSCTRACE(logger, "Publishing cache from " << rsbInformerTransform->getId().getIdAsString());
 
-	map<string, std::pair<Transform, MetaData> >::iterator it;
-	for (it = sendCacheDynamic.begin(); it != sendCacheDynamic.end(); it++) {
-		EventPtr event(rsbInformerTransform->createEvent());
-		event->setData(boost::make_shared<Transform>(it->second.first));
-		event->setScope(rsbInformerTransform->getScope()->concat(Scope(scopeSuffixDynamic)));
-		event->setMetaData(it->second.second);
-		rsbInformerTransform->publish(event);
+	// publish from a snapshot so that sending transforms is not blocked
+	vector<std::pair<Transform, MetaData> > dynamicCache;
+	vector<std::pair<Transform, MetaData> > staticCache;
+	boost::uint64_t snapshot = 0;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		map<string, std::pair<Transform, MetaData> >::const_iterator it;
+		if (includeDynamic) {
+			// the full cache supersedes every message sent so far
+			snapshot = sequence;
+			dynamicCache.reserve(sendCacheDynamic.size());
+			for (it = sendCacheDynamic.begin(); it != sendCacheDynamic.end(); ++it) {
+				dynamicCache.push_back(it->second);
+			}
+		}
+		staticCache.reserve(sendCacheStatic.size());
+		for (it = sendCacheStatic.begin(); it != sendCacheStatic.end(); ++it) {
+			staticCache.push_back(it->second);
+		}
 	}
-	for (it = sendCacheStatic.begin(); it != sendCacheStatic.end(); it++) {
-		EventPtr event(rsbInformerTransform->createEvent());
-		event->setData(boost::make_shared<Transform>(it->second.first));
-		event->setScope(rsbInformerTransform->getScope()->concat(Scope(scopeSuffixStatic)));
-		event->setMetaData(it->second.second);
-		rsbInformerTransform->publish(event);
+
+	publishCache(dynamicCache, rsbInformerTransform->getScope()->concat(Scope(scopeSuffixDynamic)),
+			snapshot);
+	publishCache(staticCache, rsbInformerTransform->getScope()->concat(Scope(scopeSuffixStatic)),
+			snapshot);
+}
+
+void TransformCommRsb::publishCache(const vector<std::pair<Transform, MetaData> >& cache,
+		const Scope& scope, boost::uint64_t snapshot) {
+
+	vector<std::pair<Transform, MetaData> >::const_iterator it;
+	if (!rsbInformerTransformCollection) {
+		for (it = cache.begin(); it != cache.end(); ++it) {
+			EventPtr event(rsbInformerTransform->createEvent());
+			event->setData(boost::make_shared<Transform>(it->first));
+			event->setScope(scope);
+			if (snapshot > 0) {
+				event->setMetaData(withSequence(it->second, userKeySnapshot, snapshot));
+			} else {
+				event->setMetaData(it->second);
+			}
+			rsbInformerTransform->publish(event);
+		}
+		return;
+	}
+
+	// batches of at most syncBatchSize transforms per authority
+	map<string, boost::shared_ptr<std::vector<Transform> > > collections;
+	map<string, MetaData> metas;
+	for (it = cache.begin(); it != cache.end(); ++it) {
+		const string transformAuthority = it->second.getUserInfo(userKeyAuthority);
+		boost::shared_ptr<std::vector<Transform> >& collection = collections[transformAuthority];
+		if (!collection) {
+			collection = boost::make_shared<std::vector<Transform> >();
+			collection->reserve(syncBatchSize);
+			// the authority is part of the collection
+			if (snapshot > 0) {
+				metas[transformAuthority] = withSequence(MetaData(), userKeySnapshot, snapshot);
+			}
+		}
+		collection->push_back(it->first);
+		if (collection->size() >= syncBatchSize) {
+			publishCollection(collection, transformAuthority, metas[transformAuthority], scope);
+			collection.reset();
+		}
+	}
+	map<string, boost::shared_ptr<std::vector<Transform> > >::iterator collectionIt;
+	for (collectionIt = collections.begin(); collectionIt != collections.end(); ++collectionIt) {
+		if (collectionIt->second) {
+			publishCollection(collectionIt->second, collectionIt->first, metas[collectionIt->first],
+					scope);
+		}
+	}
+}
+
+bool TransformCommRsb::resend(const vector<std::pair<boost::uint64_t, boost::uint64_t> >& ranges) {
+	// overlapping requests of several receivers are answered once
+	map<boost::uint64_t, SentMessage> messages;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		vector<std::pair<boost::uint64_t, boost::uint64_t> >::const_iterator it;
+		for (it = ranges.begin(); it != ranges.end(); ++it) {
+			if (history.empty() || it->first < history.front().sequence) {
+				return false;
+			}
+			// sequence numbers in the history are consecutive
+			boost::uint64_t first = history.front().sequence;
+			boost::uint64_t last = std::min(it->second, history.back().sequence);
+			for (boost::uint64_t s = it->first; s <= last; ++s) {
+				messages[s] = history[s - first];
+			}
+		}
+	}
+
+	RSCDEBUG(logger, "Resending " << messages.size() << " messages");
+	map<boost::uint64_t, SentMessage>::const_iterator it;
+	for (it = messages.begin(); it != messages.end(); ++it) {
+		const SentMessage& message = it->second;
+		const string& suffix = message.isStatic ? scopeSuffixStatic : scopeSuffixDynamic;
+		Scope scope = rsbInformerTransform->getScope()->concat(Scope(suffix));
+
+		if (rsbInformerTransformCollection && message.transforms->size() > 1) {
+			publishCollection(message.transforms, message.authority,
+					withSequence(MetaData(), userKeySequence, message.sequence), scope);
+			continue;
+		}
+		MetaData meta;
+		meta.setUserInfo(userKeyAuthority, message.authority);
+		meta = withSequence(meta, userKeySequence, message.sequence);
+		std::vector<Transform>::const_iterator t;
+		for (t = message.transforms->begin(); t != message.transforms->end(); ++t) {
+			EventPtr event(rsbInformerTransform->createEvent());
+			event->setData(boost::make_shared<Transform>(*t));
+			event->setScope(scope);
+			event->setMetaData(meta);
+			rsbInformerTransform->publish(event);
+		}
+	}
+	return true;
+}
+
+bool TransformCommRsb::SequenceState::receive(boost::uint64_t sequence) {
+	if (sequence > highest) {
+		// messages sent before the first one received are covered by the
+		// initial sync
+		bool gap = highest > 0 && sequence > highest + 1;
+		if (gap) {
+			missing[highest + 1] = sequence - 1;
+			requestPending = true;
+		}
+		highest = sequence;
+		return gap;
+	}
+
+	// late or resent message, split the missing range containing it
+	std::map<boost::uint64_t, boost::uint64_t>::iterator it = missing.upper_bound(sequence);
+	if (it == missing.begin()) {
+		return false;
+	}
+	--it;
+	boost::uint64_t first = it->first;
+	boost::uint64_t last = it->second;
+	if (sequence > last) {
+		return false;
+	}
+	missing.erase(it);
+	if (first < sequence) {
+		missing[first] = sequence - 1;
+	}
+	if (sequence < last) {
+		missing[sequence + 1] = last;
+	}
+	return false;
+}
+
+void TransformCommRsb::SequenceState::lose(boost::uint64_t sequence) {
+	// received but not usable, e.g. referencing unknown dictionary ids
+	missing[sequence] = sequence;
+	requestPending = true;
+}
+
+void TransformCommRsb::SequenceState::cover(boost::uint64_t snapshot) {
+	while (!missing.empty() && missing.begin()->first <= snapshot) {
+		boost::uint64_t last = missing.begin()->second;
+		missing.erase(missing.begin());
+		if (last > snapshot) {
+			missing[snapshot + 1] = last;
+			break;
+		}
+	}
+	highest = std::max(highest, snapshot);
+}
+
+void TransformCommRsb::trackSequence(const MetaData& meta) {
+	if (!meta.hasUserInfo(userKeyOrigin)) {
+		// peer without sequence numbers
+		return;
+	}
+
+	bool gap = false;
+	try {
+		boost::mutex::scoped_lock lock(sequenceMutex);
+		const boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		map<string, SequenceState>::iterator stateIt = sequenceStates.find(
+				meta.getUserInfo(userKeyOrigin));
+		if (stateIt == sequenceStates.end()) {
+			// a new peer or a restarted one, forget those gone silent
+			map<string, SequenceState>::iterator it = sequenceStates.begin();
+			while (it != sequenceStates.end()) {
+				if (now - it->second.lastReceived > originTimeout) {
+					sequenceStates.erase(it++);
+				} else {
+					++it;
+				}
+			}
+			stateIt = sequenceStates.insert(
+					make_pair(meta.getUserInfo(userKeyOrigin), SequenceState())).first;
+		}
+		SequenceState& state = stateIt->second;
+		state.lastReceived = now;
+		if (meta.hasUserInfo(userKeySnapshot)) {
+			state.cover(boost::lexical_cast<boost::uint64_t>(meta.getUserInfo(userKeySnapshot)));
+		} else if (meta.hasUserInfo(userKeySequence)) {
+			gap = state.receive(
+					boost::lexical_cast<boost::uint64_t>(meta.getUserInfo(userKeySequence)));
+		}
+	} catch (boost::bad_lexical_cast &e) {
+		RSCWARN(logger, "Ignoring invalid sequence number. Reason: " << e.what());
+		return;
+	}
+
+	if (gap) {
+		{
+			boost::mutex::scoped_lock lock(syncMutex);
+			gapCheckPending = true;
+		}
+		syncCondition.notify_one();
+	}
+}
+
+void TransformCommRsb::markLost(const MetaData& meta) {
+	if (!meta.hasUserInfo(userKeyOrigin)) {
+		return;
+	}
+	try {
+		boost::mutex::scoped_lock lock(sequenceMutex);
+		map<string, SequenceState>::iterator it = sequenceStates.find(
+				meta.getUserInfo(userKeyOrigin));
+		if (it == sequenceStates.end()) {
+			return;
+		}
+		if (meta.hasUserInfo(userKeySequence)) {
+			it->second.lose(boost::lexical_cast<boost::uint64_t>(meta.getUserInfo(userKeySequence)));
+		} else {
+			it->second.syncRequired = true;
+			it->second.requestPending = true;
+		}
+	} catch (boost::bad_lexical_cast &e) {
+		RSCWARN(logger, "Ignoring invalid sequence number. Reason: " << e.what());
+	}
+}
+
+void TransformCommRsb::publishDictionary() {
+	// an empty message announcing all entries, the decoders of both
+	// encodings share the dictionary
+	boost::shared_ptr<TransformCollection> collection = boost::make_shared<TransformCollection>();
+	boost::shared_ptr<proto::CompactTransformCollection> compact;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (dictionary.size() == 0) {
+			return;
+		}
+		collection->hasIds = true;
+		collection->authority = dictionary.encode(authority);
+		for (size_t id = 0; id < dictionary.size(); ++id) {
+			collection->dictionary.push_back(dictionary.getName(id));
+		}
+		dictionaryAnnounced = dictionary.size();
+		if (!rsbInformerTransformCollection && rsbInformerCompact) {
+			compact = boost::make_shared<proto::CompactTransformCollection>();
+			compact->set_translation_resolution(quantizer->getTranslationResolution());
+			compact->set_rotation_resolution(quantizer->getRotationResolution());
+			compact->set_authority(collection->authority);
+			compact->set_dictionary_offset(0);
+			for (size_t id = 0; id < collection->dictionary.size(); ++id) {
+				compact->add_dictionary(collection->dictionary[id]);
+			}
+		}
+	}
+
+	RSCDEBUG(logger, "Announcing " << collection->dictionary.size() << " dictionary entries");
+	MetaData meta;
+	meta.setUserInfo(userKeyOrigin, origin);
+	if (rsbInformerTransformCollection) {
+		EventPtr event(rsbInformerTransformCollection->createEvent());
+		event->setData(collection);
+		event->setMetaData(meta);
+		event->setScope(rsbInformerTransformCollection->getScope()->concat(Scope(scopeSuffixDynamic)));
+		rsbInformerTransformCollection->publish(event);
+	} else if (compact) {
+		EventPtr event(rsbInformerCompact->createEvent());
+		event->setData(compact);
+		event->setMetaData(meta);
+		event->setScope(rsbInformerCompact->getScope()->concat(Scope(scopeSuffixDynamic)));
+		rsbInformerCompact->publish(event);
+	}
+}
+
+void TransformCommRsb::requestMissing() {
+	vector<MetaData> requests;
+	{
+		boost::mutex::scoped_lock lock(decodeMutex);
+		set<string>::const_iterator it;
+		for (it = dictionaryRequests.begin(); it != dictionaryRequests.end(); ++it) {
+			MetaData meta;
+			meta.setUserInfo(userKeySyncOrigin, *it);
+			meta.setUserInfo(userKeySyncMode, "dictionary");
+			requests.push_back(meta);
+		}
+		for (it = keyframeRequests.begin(); it != keyframeRequests.end(); ++it) {
+			MetaData meta;
+			meta.setUserInfo(userKeySyncOrigin, *it);
+			meta.setUserInfo(userKeySyncMode, "keyframe");
+			requests.push_back(meta);
+		}
+		dictionaryRequests.clear();
+		keyframeRequests.clear();
+	}
+	{
+		boost::mutex::scoped_lock lock(sequenceMutex);
+		map<string, SequenceState>::iterator it;
+		for (it = sequenceStates.begin(); it != sequenceStates.end(); ++it) {
+			SequenceState& state = it->second;
+			if (!state.requestPending) {
+				continue;
+			}
+			state.requestPending = false;
+
+			if (state.syncRequired || state.missing.size() > maxRangesPerOrigin) {
+				state.syncRequired = false;
+				MetaData meta;
+				meta.setUserInfo(userKeySyncOrigin, it->first);
+				meta.setUserInfo(userKeySyncMode, "full");
+				requests.push_back(meta);
+				continue;
+			}
+			map<boost::uint64_t, boost::uint64_t>::const_iterator range;
+			for (range = state.missing.begin(); range != state.missing.end(); ++range) {
+				MetaData meta;
+				meta.setUserInfo(userKeySyncOrigin, it->first);
+				meta.setUserInfo(userKeySyncMode, "range");
+				meta.setUserInfo(userKeySyncFrom, boost::lexical_cast<string>(range->first));
+				meta.setUserInfo(userKeySyncTo, boost::lexical_cast<string>(range->second));
+				requests.push_back(meta);
+			}
+		}
+	}
+
+	vector<MetaData>::const_iterator it;
+	for (it = requests.begin(); it != requests.end(); ++it) {
+		RSCDEBUG(logger, "Requesting missing messages from " << it->getUserInfo(userKeySyncOrigin));
+		publishSyncRequest(*it);
 	}
 }
 
 void TransformCommRsb::addTransformListener(const TransformListener::Ptr& l) {
-	boost::mutex::scoped_lock(mutex);
-	listeners.push_back(l);
+	listeners.add(l);
 }
 
 void TransformCommRsb::addTransformListener(const vector<TransformListener::Ptr>& l) {
-	boost::mutex::scoped_lock(mutex);
-	listeners.insert(listeners.end(), l.begin(), l.end());
+	listeners.add(l);
 }
 
 void TransformCommRsb::removeTransformListener(const TransformListener::Ptr& l) {
-	boost::mutex::scoped_lock(mutex);
-	vector<TransformListener::Ptr>::iterator it = find(listeners.begin(), listeners.end(), l);
-	if (it != listeners.end()) {
-		listeners.erase(it);
+	listeners.remove(l);
+}
+
+bool TransformCommRsb::isOwnEvent(const EventPtr& event) const {
+	const rsc::misc::UUID& sender = event->getMetaData().getSenderId();
+	if (sender == rsbInformerTransform->getId()) {
+		return true;
+	}
+	if (rsbInformerTransformCollection && sender == rsbInformerTransformCollection->getId()) {
+		return true;
 	}
+	return rsbInformerCompact && sender == rsbInformerCompact->getId();
 }
 
 void TransformCommRsb::transformCallback(EventPtr event) {
-	if (event->getMetaData().getSenderId() == rsbInformerTransform->getId()) {
+	if (isOwnEvent(event)) {
 		RSCTRACE(logger,
 				"Received transform from myself. Ignore. (id " << event->getMetaData().getSenderId().getIdAsString() << ")");
 		return;
 	}
+	if (!process.empty() && event->getMetaData().hasUserInfo(userKeyProcess)
+			&& event->getMetaData().getUserInfo(userKeyProcess) == process) {
+		RSCTRACE(logger, "Received transform from this process, delivered by loopback. Ignore.");
+		return;
+	}
 
-	boost::shared_ptr<Transform> t = boost::static_pointer_cast<Transform>(event->getData());
-	string authority = event->getMetaData().getUserInfo(userKeyAuthority);
+	// compact messages and collections carry the authority in the dictionary
+	string authority;
+	if (event->getMetaData().hasUserInfo(userKeyAuthority)) {
+		authority = event->getMetaData().getUserInfo(userKeyAuthority);
+	}
+	trackSequence(event->getMetaData());
 
 	Scope staticScope = rsbInformerTransform->getScope()->concat(Scope(scopeSuffixStatic));
 	bool isStatic = (event->getScope() == staticScope);
 
+	if (event->getType() == rsc::runtime::typeName<proto::CompactTransformCollection>()) {
+		std::vector<Transform> ts;
+		decodeCompact(event, ts);
+		RSCDEBUG(logger, "Received " << ts.size() << " compact transforms");
+		if (!ts.empty()) {
+			listeners.notify(ts, isStatic);
+		}
+		return;
+	}
+
+	if (event->getType() == rsc::runtime::typeName<TransformCollection>()) {
+		boost::shared_ptr<TransformCollection> collection = boost::static_pointer_cast<
+				TransformCollection>(event->getData());
+		std::vector<Transform>& ts = *collection->transforms;
+		if (collection->hasIds) {
+			if (!decodeNames(event, *collection)) {
+				// the dictionary and this message are requested again
+				markLost(event->getMetaData());
+				return;
+			}
+		} else {
+			std::vector<Transform>::iterator it;
+			for (it = ts.begin(); it != ts.end(); ++it) {
+				it->setAuthority(authority);
+			}
+		}
+		RSCDEBUG(logger, "Received " << ts.size() << " transforms");
+		if (!ts.empty()) {
+			listeners.notify(ts, isStatic);
+		}
+		return;
+	}
+
+	boost::shared_ptr<Transform> t = boost::static_pointer_cast<Transform>(event->getData());
+
 	t->setAuthority(authority);
 	RSCDEBUG(logger, "Received transform from " << authority);
 	RSCTRACE(logger, "Received transform: " << *t);
 
-	boost::mutex::scoped_lock(mutex);
-	vector<TransformListener::Ptr>::iterator it0;
-	for (it0 = listeners.begin(); it0 != listeners.end(); ++it0) {
-		TransformListener::Ptr l = *it0;
-		l->newTransformAvailable(*t, isStatic);
-	}
+	listeners.notify(*t, isStatic);
 }
 
 void TransformCommRsb::triggerCallback(EventPtr e) {
@@ -253,15 +1180,63 @@ void TransformCommRsb::triggerCallback(EventPtr e) {
 		return;
 	}
 
-	// publish send cache as thread
-	boost::thread workerThread(&TransformCommRsb::publishCache, this);
+	// requests without parameters come from older peers and mean a full sync
+	const MetaData& meta = e->getMetaData();
+	if (meta.hasUserInfo(userKeySyncOrigin) && meta.getUserInfo(userKeySyncOrigin) != origin) {
+		RSCTRACE(logger, "Sync request for " << meta.getUserInfo(userKeySyncOrigin) << ". Ignore.");
+		return;
+	}
+	string mode = meta.hasUserInfo(userKeySyncMode) ? meta.getUserInfo(userKeySyncMode) : "full";
+
+	if (mode == "full" || mode == "static" || mode == "keyframe") {
+		// the next message announces the whole dictionary again
+		boost::mutex::scoped_lock lock(mutex);
+		dictionaryAnnounced = 0;
+		if (mode == "keyframe" && quantizer) {
+			// and lets a receiver with a new or broken decoder resynchronize
+			quantizer->requestKeyframes();
+		}
+	}
+	if (mode == "keyframe") {
+		return;
+	}
+
+	// answered by the sync responder, which coalesces bursts of requests
+	{
+		boost::mutex::scoped_lock lock(syncMutex);
+		if (mode == "static") {
+			staticSyncPending = true;
+		} else if (mode == "dictionary") {
+			// only the entries, lost messages are requested as ranges
+			dictionaryPending = true;
+		} else if (mode == "range" && meta.hasUserInfo(userKeySyncFrom)
+				&& meta.hasUserInfo(userKeySyncTo)) {
+			try {
+				resendRequests.push_back(
+						make_pair(
+								boost::lexical_cast<boost::uint64_t>(
+										meta.getUserInfo(userKeySyncFrom)),
+								boost::lexical_cast<boost::uint64_t>(
+										meta.getUserInfo(userKeySyncTo))));
+			} catch (boost::bad_lexical_cast &ex) {
+				RSCWARN(logger, "Invalid resend request. Answering with full sync.");
+				syncPending = true;
+			}
+		} else {
+			syncPending = true;
+		}
+	}
+	syncCondition.notify_one();
 }
 
 void TransformCommRsb::printContents(std::ostream& stream) const {
 	stream << "authority = " << authority;
+	stream << ", origin = " << origin;
 	stream << ", communication = rsb";
 	stream << ", #listeners = " << listeners.size();
 	stream << ", #cache = " << sendCacheDynamic.size();
+	stream << ", sequence = " << sequence;
+	stream << ", #history = " << history.size();
 }
 
 string TransformCommRsb::getAuthorityName() const {
@@ -8,13 +8,23 @@
 #pragma once
 
 #include <rct/impl/TransformCommunicator.h>
+#include <rct/impl/TransformListenerList.h>
+#include <rct/impl/TransformQuantizer.h>
+#include <rct/impl/NameDictionary.h>
 #define BOOST_SIGNALS_NO_DEPRECATION_WARNING
 #include <rsb/Listener.h>
 #include <rsb/Informer.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <rsc/logging/Logger.h>
+#include <deque>
+#include <set>
 
 namespace rct {
+namespace proto {
+class CompactTransformCollection;
+}
+class TransformCollection;
 
 class TransformCommRsb: public TransformCommunicator {
 public:
@@ -36,6 +46,9 @@ public:
 	virtual void shutdown();
 	virtual void requestSync();
 
+	/** \brief Request only the static transforms of all peers. */
+	void requestStaticSync();
+
 	/** \brief Add transform information to the rct data structure
 	 * \param transform The transform to store
 	 * \param authority The source of the information for this transform
@@ -56,9 +69,12 @@ public:
 private:
 	rsb::ListenerPtr rsbListenerTransform;
 	rsb::Informer<Transform>::Ptr rsbInformerTransform;
+	rsb::Informer<TransformCollection>::Ptr rsbInformerTransformCollection;
+	rsb::Informer<proto::CompactTransformCollection>::Ptr rsbInformerCompact;
 	rsb::ListenerPtr rsbListenerSync;
 	rsb::Informer<void>::Ptr rsbInformerSync;
-	std::vector<TransformListener::Ptr> listeners;
+	TransformListenerList listeners;
+	// guards the send caches
 	boost::mutex mutex;
 	std::map<std::string, std::pair<Transform, rsb::MetaData> > sendCacheDynamic;
 	std::map<std::string, std::pair<Transform, rsb::MetaData> > sendCacheStatic;
@@ -70,16 +86,124 @@ private:
 	std::string scopeSuffixStatic;
 	std::string scopeSuffixDynamic;
 	std::string userKeyAuthority;
+	// Unique id of this communicator, sent as origin of every message. The
+	// authority is not unique, several processes may use the same name.
+	std::string origin;
+	// id of this process if local peers are served by the loopback
+	std::string process;
+
+	// single worker answering (coalesced) sync requests
+	boost::thread syncResponder;
+	boost::mutex syncMutex;
+	boost::condition_variable syncCondition;
+	bool syncPending;
+	bool dictionaryPending;
+	bool syncRunning;
+	boost::posix_time::time_duration syncWindow;
+	size_t syncBatchSize;
+	bool staticSyncPending;
+	bool gapCheckPending;
+	std::vector<std::pair<boost::uint64_t, boost::uint64_t> > resendRequests;
+
+	// Every sent message gets the next sequence number of this communicator.
+	// The most recent messages are kept to answer resend requests (guarded
+	// by mutex).
+	class SentMessage {
+	public:
+		boost::uint64_t sequence;
+		boost::shared_ptr<std::vector<Transform> > transforms;
+		std::string authority;
+		bool isStatic;
+	};
+	boost::uint64_t sequence;
+	size_t historySize;
+	std::deque<SentMessage> history;
+
+	// Received sequence numbers per remote origin. Missing ranges are
+	// requested from the origin after the sync window passed without them
+	// arriving (messages of the single and the collection informer may be
+	// reordered). A restarted peer has a new origin and therefore starts with
+	// a new state. States of origins silent for a long time are dropped.
+	class SequenceState {
+	public:
+		SequenceState() :
+				highest(0), requestPending(false), syncRequired(false) {
+		}
+		boost::uint64_t highest;
+		// first -> last sequence number of every missing range
+		std::map<boost::uint64_t, boost::uint64_t> missing;
+		bool requestPending;
+		// a message without sequence number (answering a sync) was lost
+		bool syncRequired;
+		boost::posix_time::ptime lastReceived;
+
+		bool receive(boost::uint64_t sequence);
+		void lose(boost::uint64_t sequence);
+		void cover(boost::uint64_t snapshot);
+	};
+	boost::mutex sequenceMutex;
+	std::map<std::string, SequenceState> sequenceStates;
+
+	// Frame and authority names of collections and of the compact encoding
+	// are referenced by ids of this sender's name dictionary. The quantizer
+	// and the dictionary are guarded by mutex, the decoders (one per origin,
+	// so senders sharing an authority never share state) by decodeMutex.
+	boost::shared_ptr<TransformQuantizer> quantizer;
+	NameDictionary dictionary;
+	size_t dictionaryAnnounced;
+	class Decoder {
+	public:
+		TransformDequantizer dequantizer;
+		NameDictionary dictionary;
+		boost::posix_time::ptime lastReceived;
+	};
+	boost::mutex decodeMutex;
+	std::map<std::string, Decoder> decoders;
+	// origins whose dictionary is incomplete
+	std::set<std::string> dictionaryRequests;
+	// origins with samples that cannot be decoded before their next keyframe
+	std::set<std::string> keyframeRequests;
 
+	bool isOwnEvent(const rsb::EventPtr& event) const;
 	void transformCallback(rsb::EventPtr t);
+	bool sendCompact(const std::vector<Transform>& transforms);
+	void decodeCompact(const rsb::EventPtr& event, std::vector<Transform>& transforms);
+	bool decodeNames(const rsb::EventPtr& event, TransformCollection& collection);
+	Decoder& getDecoder(const std::string& origin);
+	std::string getOrigin(const rsb::MetaData& meta) const;
 	void triggerCallback(rsb::EventPtr t);
-	void publishCache();
+	void respondToSyncRequests();
+	void stopSyncResponder();
+	void publishCache(bool includeDynamic);
+	void publishCache(const std::vector<std::pair<Transform, rsb::MetaData> >& cache,
+			const rsb::Scope& scope, boost::uint64_t snapshot);
+	void publishCollection(const boost::shared_ptr<std::vector<Transform> >& transforms,
+			const std::string& authority, const rsb::MetaData& meta, const rsb::Scope& scope);
+	bool resend(const std::vector<std::pair<boost::uint64_t, boost::uint64_t> >& ranges);
+	void remember(boost::uint64_t sequence,
+			const boost::shared_ptr<std::vector<Transform> >& transforms,
+			const std::string& authority, bool isStatic);
+	rsb::MetaData withSequence(const rsb::MetaData& meta, const std::string& key,
+			boost::uint64_t value) const;
+	void trackSequence(const rsb::MetaData& meta);
+	void markLost(const rsb::MetaData& meta);
+	void publishDictionary();
+	void requestMissing();
+	void publishSyncRequest(const rsb::MetaData& meta);
 
 	static std::string defaultScopeSync;
 	static std::string defaultScopeTransforms;
 	static std::string defaultScopeSufficStatic;
 	static std::string defaultScopeSuffixDynamic;
 	static std::string defaultUserKeyAuthority;
+	static std::string userKeyOrigin;
+	static std::string userKeySequence;
+	static std::string userKeySnapshot;
+	static std::string userKeySyncOrigin;
+	static std::string userKeySyncMode;
+	static std::string userKeySyncFrom;
+	static std::string userKeySyncTo;
+	static std::string userKeyProcess;
 	static rsc::logging::LoggerPtr logger;
 };
 }  // namespace rct
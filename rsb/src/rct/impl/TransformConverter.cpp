@@ -11,6 +11,8 @@
 #include <rsb/converter/SerializationException.h>
 #include <rsb/converter/ProtocolBufferConverter.h>
 
+#include <boost/thread/tss.hpp>
+
 #include <openbase/type/geometry/FrameTransform.pb.h>
 #include <openbase/type/geometry/Pose.pb.h>
 
@@ -22,24 +24,33 @@ using namespace openbase::type::geometry;
 
 namespace rct {
 
-void domainToRST(const Transform& transform, FrameTransform &t) {
-	boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+// protobuf messages reused by every conversion running on the same thread
+static boost::thread_specific_ptr<FrameTransform> serializeProto;
+static boost::thread_specific_ptr<FrameTransform> deserializeProto;
+
+static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+static const size_t poolCapacity = 1024;
+
+void TransformConverter::domainToRST(const Transform& transform, FrameTransform &t) {
 	boost::posix_time::time_duration::tick_type microTime =
 			(transform.getTime() - epoch).total_microseconds();
 
+	// both are computed from the affine matrix, so compute them only once
+	const Eigen::Vector3d translation = transform.getTranslation();
+	const Eigen::Quaterniond rotation = transform.getRotationQuat();
+
 	t.set_frame_parent(transform.getFrameParent());
 	t.set_frame_child(transform.getFrameChild());
 	t.mutable_time()->set_time(microTime);
-	t.mutable_transform()->mutable_translation()->set_x(transform.getTranslation().x());
-	t.mutable_transform()->mutable_translation()->set_y(transform.getTranslation().y());
-	t.mutable_transform()->mutable_translation()->set_z(transform.getTranslation().z());
-	t.mutable_transform()->mutable_rotation()->set_qw(transform.getRotationQuat().w());
-	t.mutable_transform()->mutable_rotation()->set_qx(transform.getRotationQuat().x());
-	t.mutable_transform()->mutable_rotation()->set_qy(transform.getRotationQuat().y());
-	t.mutable_transform()->mutable_rotation()->set_qz(transform.getRotationQuat().z());
+	t.mutable_transform()->mutable_translation()->set_x(translation.x());
+	t.mutable_transform()->mutable_translation()->set_y(translation.y());
+	t.mutable_transform()->mutable_translation()->set_z(translation.z());
+	t.mutable_transform()->mutable_rotation()->set_qw(rotation.w());
+	t.mutable_transform()->mutable_rotation()->set_qx(rotation.x());
+	t.mutable_transform()->mutable_rotation()->set_qy(rotation.y());
+	t.mutable_transform()->mutable_rotation()->set_qz(rotation.z());
 }
-void rstToDomain(const FrameTransform &t, Transform& transform) {
-	const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+void TransformConverter::rstToDomain(const FrameTransform &t, Transform& transform) {
 	const boost::posix_time::ptime time = epoch + boost::posix_time::microseconds(t.time().time());
 
 	Eigen::Vector3d p(t.transform().translation().x(), t.transform().translation().y(),
@@ -60,6 +71,7 @@ TransformConverter::TransformConverter():
                         rsc::runtime::typeName<FrameTransform>(),
                         RSB_TYPE_TAG(Transform)) {
 	converter = boost::shared_ptr<Converter<string> >(new ProtocolBufferConverter<FrameTransform>);
+	pool = TransformPool::Ptr(new TransformPool(poolCapacity));
 }
 
 TransformConverter::~TransformConverter() {
@@ -73,30 +85,41 @@ std::string TransformConverter::serialize(const rsb::AnnotatedData& data, std::s
 	// Cast to original domain type
     boost::shared_ptr<Transform> domain = static_pointer_cast<Transform>(data.second);
 
-	// Fill protocol buffer object
-	openbase::type::geometry::FrameTransform proto;
-
-	//
-	domainToRST(*domain, proto);
-
-	// Use embedded ProtoBuf converter for serialization to wire
-	return converter->serialize(
-			make_pair(rsc::runtime::typeName<openbase::type::geometry::FrameTransform>(),
-					boost::shared_ptr<void>(&proto, rsc::misc::NullDeleter())), wire);
+	// Fill the thread's protocol buffer object
+	if (!serializeProto.get()) {
+		serializeProto.reset(new FrameTransform());
+	}
+	domainToRST(*domain, *serializeProto);
+
+	// Serialize directly instead of through the embedded converter, which
+	// would require a freshly allocated message
+	if (!serializeProto->SerializeToString(&wire)) {
+		throw SerializationException("Failed to serialize FrameTransform");
+	}
+	return getWireSchema();
 }
 
 rsb::AnnotatedData TransformConverter::deserialize(const std::string& wireType,
 		const std::string& wire) {
 
-	// Deserialize and cast to specific ProtoBuf type
-	boost::shared_ptr<openbase::type::geometry::FrameTransform> proto = boost::static_pointer_cast<openbase::type::geometry::FrameTransform>(
-			converter->deserialize(wireType, wire).second);
+	if (wireType != getWireSchema()) {
+		throw SerializationException("Unexpected wire schema " + wireType);
+	}
+
+	// Parse into the thread's protocol buffer object
+	if (!deserializeProto.get()) {
+		deserializeProto.reset(new FrameTransform());
+	}
+	if (!deserializeProto->ParseFromString(wire)) {
+		throw SerializationException("Failed to parse FrameTransform");
+	}
 
-	// Instantiate domain object
-	boost::shared_ptr<Transform> domain(new Transform());
+	// Domain objects return to the pool when the last reference is released
+	boost::shared_ptr<Transform> domain = pool->acquire();
+	domain->setAuthority("");
 
 	// Read domain data from ProtoBuf
-	rstToDomain(*proto, *domain);
+	rstToDomain(*deserializeProto, *domain);
 
 	return rsb::AnnotatedData(getDataType(), domain);
 }
@@ -12,9 +12,20 @@
 #include <boost/shared_ptr.hpp>
 
 #include <rsb/converter/Converter.h>
+#include "TransformPool.h"
+
+namespace openbase {
+namespace type {
+namespace geometry {
+class FrameTransform;
+}
+}
+}
 
 namespace rct {
 
+class Transform;
+
 class TransformConverter: public rsb::converter::Converter<std::string>  {
 public:
 	typedef boost::shared_ptr<TransformConverter> Ptr;
@@ -28,9 +39,13 @@ public:
     rsb::AnnotatedData deserialize(const std::string &wireType,
             const std::string &wire);
 
+    static void domainToRST(const Transform& transform, openbase::type::geometry::FrameTransform &t);
+    static void rstToDomain(const openbase::type::geometry::FrameTransform &t, Transform& transform);
+
 private:
 
     boost::shared_ptr<rsb::converter::Converter<std::string> > converter;
+    TransformPool::Ptr pool;
 };
 
 } /* namespace rct */
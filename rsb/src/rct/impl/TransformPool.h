@@ -0,0 +1,135 @@
+/*
+ * TransformPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/atomic.hpp>
+#include <new>
+
+namespace rct {
+
+/**
+ * Bounded pool of domain objects for the receive path.
+ *
+ * Free objects are kept in a lock-free queue. acquire() hands out a
+ * shared_ptr whose deleter returns the object to the queue once the last
+ * reference is gone, so frame name strings and vectors keep their capacity
+ * for the next deserialization. The control blocks of the shared_ptrs are
+ * recycled the same way, so a steady receive path does not allocate. If the
+ * queue is empty a new object is created; if it is full when an object comes
+ * back, the object is deleted. Objects may outlive the pool, the free list
+ * is released with the last of them.
+ */
+template<class T>
+class RecyclingPool: public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<RecyclingPool<T> > Ptr;
+
+	RecyclingPool(size_t capacity) :
+			freeList(new FreeList(std::max<size_t>(1, capacity))) {
+	}
+
+	boost::shared_ptr<T> acquire() {
+		T* object = 0;
+		if (!freeList->objects.pop(object)) {
+			object = new T();
+		}
+		return boost::shared_ptr<T>(object, Release(freeList), BlockAllocator<T>(freeList));
+	}
+
+private:
+	class FreeList: public boost::noncopyable {
+	public:
+		FreeList(size_t capacity) :
+				objects(capacity), blocks(capacity), blockSize(0) {
+		}
+		~FreeList() {
+			T* object;
+			while (objects.pop(object)) {
+				delete object;
+			}
+			void* block;
+			while (blocks.pop(block)) {
+				::operator delete(block);
+			}
+		}
+		// bounded pushes never allocate nodes beyond the capacity
+		boost::lockfree::queue<T*> objects;
+		boost::lockfree::queue<void*> blocks;
+		// size of the control blocks, all of them have the same type
+		boost::atomic<size_t> blockSize;
+	};
+
+	template<class U>
+	class BlockAllocator {
+	public:
+		typedef U value_type;
+		template<class V>
+		struct rebind {
+			typedef BlockAllocator<V> other;
+		};
+
+		BlockAllocator(const boost::shared_ptr<FreeList>& freeList) :
+				freeList(freeList) {
+		}
+		template<class V>
+		BlockAllocator(const BlockAllocator<V>& other) :
+				freeList(other.freeList) {
+		}
+
+		U* allocate(size_t n) {
+			size_t size = n * sizeof(U);
+			size_t expected = 0;
+			freeList->blockSize.compare_exchange_strong(expected, size);
+			void* block = 0;
+			if (size != freeList->blockSize || !freeList->blocks.pop(block)) {
+				block = ::operator new(size);
+			}
+			return static_cast<U*>(block);
+		}
+		void deallocate(U* p, size_t n) {
+			if (n * sizeof(U) != freeList->blockSize || !freeList->blocks.bounded_push(p)) {
+				::operator delete(p);
+			}
+		}
+
+		template<class V>
+		bool operator==(const BlockAllocator<V>& other) const {
+			return freeList == other.freeList;
+		}
+		template<class V>
+		bool operator!=(const BlockAllocator<V>& other) const {
+			return freeList != other.freeList;
+		}
+
+		boost::shared_ptr<FreeList> freeList;
+	};
+
+	class Release {
+	public:
+		Release(const boost::shared_ptr<FreeList>& freeList) :
+				freeList(freeList) {
+		}
+		void operator()(T* object) {
+			if (!freeList->objects.bounded_push(object)) {
+				delete object;
+			}
+		}
+	private:
+		boost::shared_ptr<FreeList> freeList;
+	};
+
+	boost::shared_ptr<FreeList> freeList;
+};
+
+typedef RecyclingPool<Transform> TransformPool;
+
+} /* namespace rct */
@@ -0,0 +1,450 @@
+/*
+ * TransformBufferShm.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformBufferShm.h"
+#include <rct/impl/TransformQuantizer.h>
+#include <tf2/exceptions.h>
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/thread/thread.hpp>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <signal.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace boost::interprocess;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformBufferShm::logger = rsc::logging::Logger::getLogger(
+		"rct.shm.TransformBufferShm");
+
+static const boost::uint32_t bufferMagic = 0x52435442;  // "RCTB"
+static const boost::uint32_t bufferVersion = 1;
+static const unsigned int maxReadAttempts = 16;
+
+enum SegmentState {
+	SEGMENT_FRESH = 0, SEGMENT_INITIALIZING = 1, SEGMENT_READY = 2
+};
+
+struct TransformBufferShm::Header {
+	boost::atomic<boost::uint32_t> state;
+	boost::uint32_t magic;
+	boost::uint32_t version;
+	boost::uint32_t sampleSize;
+	boost::uint32_t frameCapacity;
+	boost::uint32_t sampleCapacity;
+	boost::atomic<boost::uint32_t> frameCount;
+	// process id of the writer, 0 if none
+	boost::atomic<boost::uint32_t> writer;
+	boost::atomic<boost::uint64_t> generation;
+};
+
+struct TransformBufferShm::Frame {
+	char name[TransformRecord::nameSize];
+	// number of samples ever written
+	boost::atomic<boost::uint64_t> head;
+	boost::atomic<boost::uint32_t> isStatic;
+};
+
+struct TransformBufferShm::SampleData {
+	boost::uint32_t parent;
+	// microseconds since epoch
+	boost::int64_t time;
+	double translation[3];
+	// x, y, z, w
+	double rotation[4];
+};
+
+struct TransformBufferShm::Sample {
+	// 2 * index + 1 while the sample is written, 2 * index + 2 afterwards
+	boost::atomic<boost::uint64_t> sequence;
+	SampleData data;
+};
+
+static size_t segmentSize(boost::uint32_t frameCapacity, boost::uint32_t sampleCapacity) {
+	return sizeof(TransformBufferShm::Header) + frameCapacity * sizeof(TransformBufferShm::Frame)
+			+ size_t(frameCapacity) * sampleCapacity * sizeof(TransformBufferShm::Sample);
+}
+
+static string formatTime(boost::int64_t microseconds) {
+	return boost::str(boost::format("%.6f") % (microseconds / 1e6));
+}
+
+TransformBufferShm::TransformBufferShm(const string& name, boost::uint32_t frameCapacity,
+		boost::uint32_t sampleCapacity, bool writer) :
+		name(name), writer(writer), header(0), frames(0), samples(0), knownFrames(0) {
+
+	if (!boost::atomic<boost::uint64_t>().is_lock_free()
+			|| !boost::atomic<boost::uint32_t>().is_lock_free()) {
+		throw std::runtime_error("Shared memory buffer requires lock-free atomics");
+	}
+	if (frameCapacity == 0 || sampleCapacity < 2) {
+		throw std::invalid_argument("Shared memory buffer needs frames and at least two samples");
+	}
+
+	shm = shared_memory_object(open_or_create, name.c_str(), read_write);
+	offset_t size = 0;
+	shm.get_size(size);
+	if (size == 0) {
+		// a new segment is zero filled
+		shm.truncate(segmentSize(frameCapacity, sampleCapacity));
+	}
+	region = mapped_region(shm, read_write);
+	header = static_cast<Header*>(region.get_address());
+
+	boost::uint32_t expected = SEGMENT_FRESH;
+	if (header->state.compare_exchange_strong(expected, SEGMENT_INITIALIZING)) {
+		RSCDEBUG(logger, "Initializing shared memory buffer " << name);
+		header->magic = bufferMagic;
+		header->version = bufferVersion;
+		header->sampleSize = sizeof(Sample);
+		header->frameCapacity = frameCapacity;
+		header->sampleCapacity = sampleCapacity;
+		new (&header->frameCount) boost::atomic<boost::uint32_t>(0);
+		new (&header->writer) boost::atomic<boost::uint32_t>(0);
+		new (&header->generation) boost::atomic<boost::uint64_t>(0);
+		header->state.store(SEGMENT_READY);
+	} else {
+		for (int i = 0; header->state.load() != SEGMENT_READY; ++i) {
+			if (i > 1000) {
+				throw std::runtime_error("Shared memory buffer " + name + " is not initialized");
+			}
+			boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+		}
+	}
+
+	if (header->magic != bufferMagic || header->version != bufferVersion
+			|| header->sampleSize != sizeof(Sample)) {
+		throw std::runtime_error("Shared memory buffer " + name + " has an incompatible layout");
+	}
+	if (region.get_size() < segmentSize(header->frameCapacity, header->sampleCapacity)) {
+		throw std::runtime_error("Shared memory buffer " + name + " is too small");
+	}
+	if (header->frameCapacity != frameCapacity || header->sampleCapacity != sampleCapacity) {
+		RSCWARN(logger,
+				"Using capacities " << header->frameCapacity << "/" << header->sampleCapacity << " of existing buffer " << name);
+	}
+
+	frames = reinterpret_cast<Frame*>(reinterpret_cast<char*>(header) + sizeof(Header));
+	samples = reinterpret_cast<Sample*>(reinterpret_cast<char*>(frames)
+			+ header->frameCapacity * sizeof(Frame));
+
+	if (writer) {
+		claim();
+	}
+}
+
+TransformBufferShm::~TransformBufferShm() {
+	if (writer) {
+		boost::uint32_t pid = getpid();
+		header->writer.compare_exchange_strong(pid, 0);
+	}
+}
+
+void TransformBufferShm::claim() {
+	boost::uint32_t pid = getpid();
+	boost::uint32_t current = 0;
+	while (!header->writer.compare_exchange_strong(current, pid)) {
+		if (current == pid || kill(current, 0) == 0 || errno != ESRCH) {
+			throw std::runtime_error(
+					boost::str(
+							boost::format("Shared memory buffer %1% is already written by process %2%")
+									% name % current));
+		}
+		RSCWARN(logger, "Taking over buffer " << name << " from terminated process " << current);
+	}
+}
+
+void TransformBufferShm::remove(const string& name) {
+	shared_memory_object::remove(name.c_str());
+}
+
+bool TransformBufferShm::write(const Transform& transform, bool isStatic) {
+	if (!writer) {
+		RSCERROR(logger, "Buffer " << name << " was attached read-only");
+		return false;
+	}
+	if (transform.getFrameChild().size() > TransformRecord::maxNameLength
+			|| transform.getFrameParent().size() > TransformRecord::maxNameLength) {
+		RSCWARN(logger, "Cannot store " << transform.getFrameChild() << ", name too long");
+		return false;
+	}
+	boost::uint32_t child = addFrame(transform.getFrameChild());
+	boost::uint32_t parent = addFrame(transform.getFrameParent());
+	if (child == npos || parent == npos) {
+		return false;
+	}
+
+	SampleData data;
+	data.parent = parent;
+	data.time = toMicroseconds(transform.getTime());
+	Eigen::Vector3d t = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+	data.translation[0] = t.x();
+	data.translation[1] = t.y();
+	data.translation[2] = t.z();
+	data.rotation[0] = q.x();
+	data.rotation[1] = q.y();
+	data.rotation[2] = q.z();
+	data.rotation[3] = q.w();
+
+	Frame& frame = frames[child];
+	// only this process writes, its threads are serialized, so the head
+	// cannot change meanwhile
+	boost::mutex::scoped_lock lock(writeMutex);
+	boost::uint64_t head = frame.head.load(boost::memory_order_relaxed);
+	if (!isStatic && head > 0) {
+		const Sample& last = samples[size_t(child) * header->sampleCapacity
+				+ (head - 1) % header->sampleCapacity];
+		if (data.time < last.data.time) {
+			RSCDEBUG(logger,
+					"Rejecting transform " << transform.getFrameChild() << " older than the newest sample");
+			return false;
+		}
+	}
+
+	Sample& sample = samples[size_t(child) * header->sampleCapacity + head % header->sampleCapacity];
+	sample.sequence.store(2 * head + 1, boost::memory_order_relaxed);
+	boost::atomic_thread_fence(boost::memory_order_release);
+	memcpy(&sample.data, &data, sizeof(SampleData));
+	sample.sequence.store(2 * head + 2, boost::memory_order_release);
+
+	if (isStatic) {
+		frame.isStatic.store(1, boost::memory_order_release);
+	}
+	frame.head.store(head + 1, boost::memory_order_release);
+	header->generation.fetch_add(1, boost::memory_order_release);
+	return true;
+}
+
+void TransformBufferShm::clear() {
+	if (!writer) {
+		RSCERROR(logger, "Buffer " << name << " was attached read-only");
+		return;
+	}
+	boost::mutex::scoped_lock lock(writeMutex);
+	boost::uint32_t count = header->frameCount.load(boost::memory_order_acquire);
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		// old samples no longer match the sequence readers expect
+		frames[i].head.store(0, boost::memory_order_release);
+		frames[i].isStatic.store(0, boost::memory_order_release);
+	}
+	header->generation.fetch_add(1, boost::memory_order_release);
+}
+
+boost::uint64_t TransformBufferShm::getGeneration() const {
+	return header->generation.load(boost::memory_order_acquire);
+}
+
+boost::uint32_t TransformBufferShm::findFrame(const string& frame) const {
+	boost::mutex::scoped_lock lock(framesMutex);
+	map<string, boost::uint32_t>::const_iterator it = frameIds.find(frame);
+	if (it != frameIds.end()) {
+		return it->second;
+	}
+	boost::uint32_t count = std::min(header->frameCount.load(boost::memory_order_acquire),
+			header->frameCapacity);
+	if (count == knownFrames) {
+		return npos;
+	}
+	for (; knownFrames < count; ++knownFrames) {
+		frameIds[frames[knownFrames].name] = knownFrames;
+	}
+	it = frameIds.find(frame);
+	return it != frameIds.end() ? it->second : npos;
+}
+
+boost::uint32_t TransformBufferShm::addFrame(const string& frame) {
+	boost::uint32_t id = findFrame(frame);
+	if (id != npos) {
+		return id;
+	}
+	boost::mutex::scoped_lock lock(framesMutex);
+	// another thread may have added it since
+	map<string, boost::uint32_t>::const_iterator it = frameIds.find(frame);
+	if (it != frameIds.end()) {
+		return it->second;
+	}
+	id = header->frameCount.load(boost::memory_order_relaxed);
+	if (id >= header->frameCapacity) {
+		RSCERROR(logger, "Buffer " << name << " is full, cannot add frame " << frame);
+		return npos;
+	}
+	TransformRecord::copyName(frame, frames[id].name);
+	header->frameCount.store(id + 1, boost::memory_order_release);
+	frameIds[frame] = id;
+	knownFrames = id + 1;
+	return id;
+}
+
+bool TransformBufferShm::read(boost::uint32_t frame, boost::uint64_t index,
+		SampleData& data) const {
+	const Sample& sample = samples[size_t(frame) * header->sampleCapacity
+			+ index % header->sampleCapacity];
+	boost::uint64_t before = sample.sequence.load(boost::memory_order_acquire);
+	if (before != 2 * index + 2) {
+		return false;
+	}
+	memcpy(&data, &sample.data, sizeof(SampleData));
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+	return sample.sequence.load(boost::memory_order_relaxed) == before;
+}
+
+bool TransformBufferShm::readLatest(boost::uint32_t frame, SampleData& data) const {
+	for (unsigned int i = 0; i < maxReadAttempts; ++i) {
+		boost::uint64_t head = frames[frame].head.load(boost::memory_order_acquire);
+		if (head == 0) {
+			return false;
+		}
+		if (read(frame, head - 1, data)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void TransformBufferShm::interpolate(boost::uint32_t frame, boost::int64_t time,
+		SampleData& data) const {
+	const Frame& f = frames[frame];
+	boost::uint32_t capacity = header->sampleCapacity;
+
+	for (unsigned int attempt = 0; attempt < maxReadAttempts; ++attempt) {
+		boost::uint64_t head = f.head.load(boost::memory_order_acquire);
+		SampleData high;
+		if (head == 0 || !read(frame, head - 1, high)) {
+			continue;
+		}
+		if (time > high.time) {
+			throw tf2::ExtrapolationException(
+					"Lookup would require extrapolation into the future.  Requested time "
+							+ formatTime(time) + " but the latest data is at time "
+							+ formatTime(high.time) + ", when looking up transform from frame ["
+							+ f.name + "]");
+		}
+		if (time == high.time) {
+			data = high;
+			return;
+		}
+
+		// the oldest slot is the next one the writer overwrites
+		boost::uint64_t lo = head > capacity ? head - capacity + 1 : 0;
+		boost::uint64_t hi = head - 1;
+		SampleData low;
+		if (!read(frame, lo, low)) {
+			continue;
+		}
+		if (time < low.time) {
+			throw tf2::ExtrapolationException(
+					"Lookup would require extrapolation into the past.  Requested time "
+							+ formatTime(time) + " but the earliest data is at time "
+							+ formatTime(low.time) + ", when looking up transform from frame ["
+							+ f.name + "]");
+		}
+
+		// low.time <= time < high.time
+		bool overwritten = false;
+		while (hi - lo > 1 && !overwritten) {
+			boost::uint64_t mid = lo + (hi - lo) / 2;
+			SampleData sample;
+			if (!read(frame, mid, sample)) {
+				overwritten = true;
+			} else if (sample.time <= time) {
+				lo = mid;
+				low = sample;
+			} else {
+				hi = mid;
+				high = sample;
+			}
+		}
+		if (overwritten) {
+			continue;
+		}
+
+		double ratio = high.time == low.time ? 0.0 : double(time - low.time) / double(high.time - low.time);
+		data = ratio < 0.5 ? low : high;
+		data.time = time;
+		for (int i = 0; i < 3; ++i) {
+			data.translation[i] = low.translation[i] + ratio * (high.translation[i] - low.translation[i]);
+		}
+		Eigen::Quaterniond q0(low.rotation[3], low.rotation[0], low.rotation[1], low.rotation[2]);
+		Eigen::Quaterniond q1(high.rotation[3], high.rotation[0], high.rotation[1], high.rotation[2]);
+		Eigen::Quaterniond q = q0.slerp(ratio, q1);
+		data.rotation[0] = q.x();
+		data.rotation[1] = q.y();
+		data.rotation[2] = q.z();
+		data.rotation[3] = q.w();
+		return;
+	}
+	throw tf2::ExtrapolationException(
+			string("Samples were overwritten during the lookup of frame [") + f.name + "]");
+}
+
+void TransformBufferShm::toEdge(const SampleData& data, bool isStatic,
+		TransformChainResolver::Edge& edge) const {
+	edge.parent = frames[data.parent].name;
+	edge.transform = Eigen::Translation3d(data.translation[0], data.translation[1],
+			data.translation[2])
+			* Eigen::Quaterniond(data.rotation[3], data.rotation[0], data.rotation[1],
+					data.rotation[2]);
+	edge.time = fromMicroseconds(data.time);
+	edge.isStatic = isStatic;
+}
+
+bool TransformBufferShm::getEdge(const string& frame, const boost::posix_time::ptime& time,
+		TransformChainResolver::Edge& edge) const {
+	boost::uint32_t id = findFrame(frame);
+	if (id == npos) {
+		return false;
+	}
+	bool isStatic = frames[id].isStatic.load(boost::memory_order_acquire) != 0;
+	SampleData data;
+	if (isStatic || TransformChainResolver::isLatest(time)) {
+		if (!readLatest(id, data)) {
+			return false;
+		}
+	} else {
+		if (frames[id].head.load(boost::memory_order_acquire) == 0) {
+			return false;
+		}
+		interpolate(id, toMicroseconds(time), data);
+	}
+	toEdge(data, isStatic, edge);
+	return true;
+}
+
+bool TransformBufferShm::frameExists(const string& frame) const {
+	return findFrame(frame) != npos;
+}
+
+vector<string> TransformBufferShm::getFrameNames() const {
+	boost::uint32_t count = std::min(header->frameCount.load(boost::memory_order_acquire),
+			header->frameCapacity);
+	vector<string> names;
+	names.reserve(count);
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		names.push_back(frames[i].name);
+	}
+	return names;
+}
+
+bool TransformBufferShm::isWriter() const {
+	return writer;
+}
+
+boost::uint32_t TransformBufferShm::getFrameCapacity() const {
+	return header->frameCapacity;
+}
+
+boost::uint32_t TransformBufferShm::getSampleCapacity() const {
+	return header->sampleCapacity;
+}
+
+}  // namespace rct
@@ -0,0 +1,105 @@
+/*
+ * TransformBufferShm.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <rct/impl/TransformChainResolver.h>
+#include <rct/impl/TransformRecord.h>
+#include <rsc/logging/Logger.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/cstdint.hpp>
+#include <map>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Transform history of a whole frame tree in a named shared memory segment.
+ *
+ * Exactly one process (the writer) inserts transforms, any number of
+ * processes on the host read them in place. Every frame owns a ring of
+ * samples sorted by time; each sample is protected by a seqlock, so
+ * readers never block the writer and retry or fail with an extrapolation
+ * when the writer overwrote the samples they were reading.
+ *
+ * The history length is bounded by the number of samples per frame, not
+ * by time. Samples older than the newest sample of their frame are
+ * rejected.
+ */
+class TransformBufferShm: public TransformChainResolver::EdgeSource, public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformBufferShm> Ptr;
+
+	/**
+	 * \param writer claim the segment for writing. Fails if another living
+	 *               process claimed it.
+	 */
+	TransformBufferShm(const std::string& name, boost::uint32_t frameCapacity,
+			boost::uint32_t sampleCapacity, bool writer);
+	virtual ~TransformBufferShm();
+
+	/** \return false if the transform was rejected */
+	bool write(const Transform& transform, bool isStatic);
+
+	/** \brief Drop all samples. Frame names are kept. */
+	void clear();
+
+	/** \brief Incremented with every write */
+	boost::uint64_t getGeneration() const;
+
+	virtual bool getEdge(const std::string& frame, const boost::posix_time::ptime& time,
+			TransformChainResolver::Edge& edge) const;
+	virtual bool frameExists(const std::string& frame) const;
+
+	std::vector<std::string> getFrameNames() const;
+
+	bool isWriter() const;
+	boost::uint32_t getFrameCapacity() const;
+	boost::uint32_t getSampleCapacity() const;
+
+	static void remove(const std::string& name);
+
+	struct Header;
+	struct Frame;
+	struct Sample;
+	struct SampleData;
+
+private:
+	static const boost::uint32_t npos = 0xffffffff;
+
+	std::string name;
+	bool writer;
+	boost::interprocess::shared_memory_object shm;
+	boost::interprocess::mapped_region region;
+	Header* header;
+	Frame* frames;
+	Sample* samples;
+
+	// frame ids by name, extended when the writer added frames
+	mutable boost::mutex framesMutex;
+	mutable std::map<std::string, boost::uint32_t> frameIds;
+	mutable boost::uint32_t knownFrames;
+	// serializes the writing threads of this process
+	boost::mutex writeMutex;
+
+	static rsc::logging::LoggerPtr logger;
+
+	boost::uint32_t findFrame(const std::string& frame) const;
+	boost::uint32_t addFrame(const std::string& frame);
+	bool read(boost::uint32_t frame, boost::uint64_t index, SampleData& sample) const;
+	bool readLatest(boost::uint32_t frame, SampleData& sample) const;
+	void interpolate(boost::uint32_t frame, boost::int64_t time, SampleData& sample) const;
+	void toEdge(const SampleData& sample, bool isStatic, TransformChainResolver::Edge& edge) const;
+	void claim();
+};
+
+}  // namespace rct
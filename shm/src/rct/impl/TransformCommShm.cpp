@@ -0,0 +1,232 @@
+/*
+ * TransformCommShm.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformCommShm.h"
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformCommShm::logger = rsc::logging::Logger::getLogger(
+		"rct.shm.TransformCommShm");
+
+// records of a ticket claimed by a writer that died are skipped after this
+static const boost::posix_time::time_duration pendingTimeout = boost::posix_time::milliseconds(
+		100);
+static const boost::posix_time::time_duration waitTimeout = boost::posix_time::milliseconds(100);
+static const size_t maxBatchSize = 256;
+
+static boost::uint64_t nextWriterId() {
+	// unique among all communicators of all processes on the host
+	static boost::atomic<boost::uint32_t> counter(0);
+	return (boost::uint64_t(getpid()) << 32) | (++counter);
+}
+
+TransformCommShm::TransformCommShm(const string &authority) :
+		authority(authority), writerId(nextWriterId()), running(false), stopped(false), lost(0) {
+}
+
+TransformCommShm::TransformCommShm(const string &authority, const TransformListener::Ptr& l) :
+		authority(authority), writerId(nextWriterId()), running(false), stopped(false), lost(0) {
+	addTransformListener(l);
+}
+
+TransformCommShm::TransformCommShm(const string &authority,
+		const vector<TransformListener::Ptr>& l) :
+		authority(authority), writerId(nextWriterId()), running(false), stopped(false), lost(0) {
+	addTransformListener(l);
+}
+
+TransformCommShm::~TransformCommShm() {
+	shutdown();
+}
+
+void TransformCommShm::init(const TransformerConfig &conf) {
+	RSCDEBUG(logger, "init()");
+	ring = TransformRingShm::Ptr(
+			new TransformRingShm(conf.getShmName(), conf.getShmCapacity(),
+					conf.getShmStaticCapacity()));
+
+	if (listeners.size() > 0) {
+		startReader();
+	}
+}
+
+void TransformCommShm::startReader() {
+	boost::mutex::scoped_lock lock(readerMutex);
+	if (!ring || running || stopped) {
+		return;
+	}
+	running = true;
+	reader = boost::thread(&TransformCommShm::read, this);
+}
+
+void TransformCommShm::shutdown() {
+	listeners.clear();
+	{
+		boost::mutex::scoped_lock lock(readerMutex);
+		stopped = true;
+		if (!running.exchange(false)) {
+			return;
+		}
+	}
+	if (reader.joinable() && reader.get_id() != boost::this_thread::get_id()) {
+		reader.join();
+	}
+}
+
+void TransformCommShm::requestSync() {
+	if (!ring) {
+		throw std::runtime_error("communicator was not initialized!");
+	}
+	vector<TransformRingShm::Entry> entries;
+	ring->readStatics(entries);
+	RSCDEBUG(logger, "Delivering " << entries.size() << " static transforms");
+	deliver(entries);
+}
+
+bool TransformCommShm::sendTransform(const Transform& transform, TransformType type) {
+	if (!ring) {
+		throw std::runtime_error("communicator was not initialized!");
+	}
+	if (type != STATIC && type != DYNAMIC) {
+		RSCERROR(logger, "Cannot send transform. Reason: Unknown TransformType: " << type);
+		return false;
+	}
+	if (transform.getAuthority() == "") {
+		Transform t(transform);
+		t.setAuthority(authority);
+		return ring->write(t, type == STATIC, writerId);
+	}
+	return ring->write(transform, type == STATIC, writerId);
+}
+
+bool TransformCommShm::sendTransform(const vector<Transform>& transforms, TransformType type) {
+	bool success = true;
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		success = sendTransform(*it, type) && success;
+	}
+	return success;
+}
+
+void TransformCommShm::read() {
+	// static transforms written before we started. The head is taken first,
+	// a static written meanwhile is then read twice instead of never.
+	boost::uint64_t next = ring->getHead();
+	requestSync();
+
+	boost::posix_time::ptime pendingSince;
+	vector<TransformRingShm::Entry> entries;
+	entries.reserve(maxBatchSize);
+	TransformRingShm::Entry entry;
+
+	while (running) {
+		boost::uint64_t head = ring->getHead();
+		while (next < head && entries.size() < maxBatchSize) {
+			TransformRingShm::ReadResult result = ring->read(next, entry);
+			if (result == TransformRingShm::READ_OK) {
+				if (entry.writer != writerId) {
+					entries.push_back(entry);
+				}
+				pendingSince = boost::posix_time::not_a_date_time;
+				next++;
+			} else if (result == TransformRingShm::READ_OVERRUN) {
+				boost::uint64_t oldest = head > ring->getCapacity() ? head - ring->getCapacity() : 0;
+				boost::uint64_t skipTo = std::max(next + 1, oldest);
+				lost += skipTo - next;
+				RSCDEBUG(logger, "Reader overrun, lost " << (skipTo - next) << " transforms");
+				next = skipTo;
+			} else {
+				boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+				if (pendingSince.is_special()) {
+					pendingSince = now;
+				} else if (now - pendingSince > pendingTimeout) {
+					RSCWARN(logger, "Skipping transform " << next << " that was never completed");
+					lost++;
+					next++;
+					pendingSince = boost::posix_time::not_a_date_time;
+					continue;
+				}
+				break;
+			}
+		}
+
+		if (!entries.empty()) {
+			deliver(entries);
+			entries.clear();
+			continue;
+		}
+		if (next < head) {
+			// a writer is still copying its record
+			ring->waitWritten(next, pendingTimeout);
+			continue;
+		}
+		ring->wait(head, waitTimeout);
+	}
+}
+
+void TransformCommShm::deliver(const vector<TransformRingShm::Entry>& entries) {
+	vector<Transform> dynamicTransforms;
+	vector<Transform> staticTransforms;
+	Transform transform;
+	vector<TransformRingShm::Entry>::const_iterator it;
+	for (it = entries.begin(); it != entries.end(); ++it) {
+		it->record.toTransform(transform);
+		if (it->isStatic) {
+			staticTransforms.push_back(transform);
+		} else {
+			dynamicTransforms.push_back(transform);
+		}
+	}
+	try {
+		if (!staticTransforms.empty()) {
+			listeners.notify(staticTransforms, true);
+		}
+		if (!dynamicTransforms.empty()) {
+			listeners.notify(dynamicTransforms, false);
+		}
+	} catch (std::exception &e) {
+		RSCERROR(logger, "Listener failed to apply transforms. Reason: " << e.what());
+	}
+}
+
+void TransformCommShm::addTransformListener(const TransformListener::Ptr& l) {
+	listeners.add(l);
+	startReader();
+}
+
+void TransformCommShm::addTransformListener(const vector<TransformListener::Ptr>& l) {
+	listeners.add(l);
+	startReader();
+}
+
+void TransformCommShm::removeTransformListener(const TransformListener::Ptr& l) {
+	listeners.remove(l);
+}
+
+unsigned long TransformCommShm::getLost() const {
+	return lost;
+}
+
+void TransformCommShm::printContents(std::ostream& stream) const {
+	stream << "authority = " << authority;
+	stream << ", communication = shm";
+	stream << ", #listeners = " << listeners.size();
+	if (ring) {
+		stream << ", capacity = " << ring->getCapacity();
+		stream << ", head = " << ring->getHead();
+	}
+	stream << ", lost = " << lost;
+}
+
+string TransformCommShm::getAuthorityName() const {
+	return authority;
+}
+
+}  // namespace rct
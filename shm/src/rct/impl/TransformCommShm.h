@@ -0,0 +1,74 @@
+/*
+ * TransformCommShm.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/impl/TransformCommunicator.h>
+#include <rct/impl/TransformListenerList.h>
+#include "TransformRingShm.h"
+#include <boost/atomic.hpp>
+#include <rsc/logging/Logger.h>
+
+namespace rct {
+
+/**
+ * Exchanges transforms between processes on the same host through a
+ * TransformRingShm instead of a middleware.
+ *
+ * Records are copied directly from shared memory into transforms, there
+ * is no serialization. A reader thread per communicator follows the ring
+ * and delivers the transforms of all other communicators to the listeners.
+ * It is started with the first listener, communicators that only send do
+ * not read. When it starts and on requestSync() the static table of the
+ * segment is delivered, so late joiners get all static transforms.
+ */
+class TransformCommShm: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<TransformCommShm> Ptr;
+	TransformCommShm(const std::string &authority);
+	TransformCommShm(const std::string &authority, const TransformListener::Ptr& listener);
+	TransformCommShm(const std::string &authority,
+			const std::vector<TransformListener::Ptr>& listeners);
+	virtual ~TransformCommShm();
+
+	virtual void init(const TransformerConfig &conf);
+	virtual void shutdown();
+	virtual void requestSync();
+
+	virtual bool sendTransform(const Transform& transform, TransformType type);
+	virtual bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
+
+	virtual void addTransformListener(const TransformListener::Ptr& listener);
+	virtual void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
+	virtual void removeTransformListener(const TransformListener::Ptr& listener);
+
+	/** \brief Number of records overwritten before this communicator read them */
+	unsigned long getLost() const;
+
+	void printContents(std::ostream& stream) const;
+
+	virtual std::string getAuthorityName() const;
+
+private:
+	std::string authority;
+	TransformListenerList listeners;
+	TransformRingShm::Ptr ring;
+	boost::uint64_t writerId;
+	boost::thread reader;
+	boost::mutex readerMutex;
+	boost::atomic<bool> running;
+	bool stopped;
+	boost::atomic<unsigned long> lost;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void startReader();
+	void read();
+	void deliver(const std::vector<TransformRingShm::Entry>& entries);
+};
+
+}  // namespace rct
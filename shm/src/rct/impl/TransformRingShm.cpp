@@ -0,0 +1,417 @@
+/*
+ * TransformRingShm.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformRingShm.h"
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <cerrno>
+#include <cstring>
+#include <climits>
+#include <new>
+#include <stdexcept>
+#include <signal.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <ctime>
+#endif
+
+using namespace std;
+using namespace boost::interprocess;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformRingShm::logger = rsc::logging::Logger::getLogger(
+		"rct.shm.TransformRingShm");
+
+static const boost::uint32_t ringMagic = 0x52435452;  // "RCTR"
+static const boost::uint32_t ringVersion = 3;
+
+// a slot or the static table held longer than this is taken over if its
+// holder terminated, a writer gives up otherwise
+static const boost::posix_time::time_duration holdTimeout = boost::posix_time::milliseconds(100);
+
+enum SegmentState {
+	SEGMENT_FRESH = 0, SEGMENT_INITIALIZING = 1, SEGMENT_READY = 2
+};
+
+struct TransformRingShm::Header {
+	boost::atomic<boost::uint32_t> state;
+	boost::uint32_t magic;
+	boost::uint32_t version;
+	boost::uint32_t recordSize;
+	boost::uint32_t capacity;
+	boost::uint32_t staticCapacity;
+	boost::atomic<boost::uint64_t> head;
+	// incremented with every write, waited on by readers
+	boost::atomic<boost::uint32_t> futexWord;
+	boost::atomic<boost::uint32_t> waiters;
+	// pid of the process writing the static table, 0 if none
+	boost::atomic<boost::uint32_t> staticLock;
+	boost::atomic<boost::uint32_t> staticCount;
+};
+
+struct TransformRingShm::Slot {
+	// 2 * pid + 1 of the writing process while a ticket is written, so the
+	// holder is part of the claim, 2 * ticket + 2 afterwards
+	boost::atomic<boost::uint64_t> sequence;
+	boost::uint64_t writer;
+	boost::uint32_t isStatic;
+	TransformRecord record;
+};
+
+struct TransformRingShm::StaticSlot {
+	// odd while written
+	boost::atomic<boost::uint32_t> sequence;
+	boost::uint64_t writer;
+	TransformRecord record;
+};
+
+static bool terminated(boost::uint32_t pid) {
+	return pid != 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+static boost::posix_time::ptime now() {
+	return boost::posix_time::microsec_clock::universal_time();
+}
+
+static size_t segmentSize(boost::uint32_t capacity, boost::uint32_t staticCapacity) {
+	return sizeof(TransformRingShm::Header) + capacity * sizeof(TransformRingShm::Slot)
+			+ staticCapacity * sizeof(TransformRingShm::StaticSlot);
+}
+
+TransformRingShm::TransformRingShm(const string& name, boost::uint32_t capacity,
+		boost::uint32_t staticCapacity) :
+		name(name), header(0), slots(0), statics(0) {
+
+	if (!boost::atomic<boost::uint64_t>().is_lock_free()
+			|| !boost::atomic<boost::uint32_t>().is_lock_free()) {
+		throw std::runtime_error("Shared memory transport requires lock-free atomics");
+	}
+	if (capacity == 0) {
+		throw std::invalid_argument("Ring capacity must be positive");
+	}
+
+	shm = shared_memory_object(open_or_create, name.c_str(), read_write);
+	offset_t size = 0;
+	shm.get_size(size);
+	if (size == 0) {
+		// a new segment is zero filled
+		shm.truncate(segmentSize(capacity, staticCapacity));
+	}
+	region = mapped_region(shm, read_write);
+	header = static_cast<Header*>(region.get_address());
+
+	boost::uint32_t expected = SEGMENT_FRESH;
+	if (header->state.compare_exchange_strong(expected, SEGMENT_INITIALIZING)) {
+		RSCDEBUG(logger, "Initializing shared memory segment " << name);
+		header->magic = ringMagic;
+		header->version = ringVersion;
+		header->recordSize = sizeof(TransformRecord);
+		header->capacity = capacity;
+		header->staticCapacity = staticCapacity;
+		new (&header->head) boost::atomic<boost::uint64_t>(0);
+		new (&header->futexWord) boost::atomic<boost::uint32_t>(0);
+		new (&header->waiters) boost::atomic<boost::uint32_t>(0);
+		new (&header->staticLock) boost::atomic<boost::uint32_t>(0);
+		new (&header->staticCount) boost::atomic<boost::uint32_t>(0);
+		header->state.store(SEGMENT_READY);
+	} else {
+		for (int i = 0; header->state.load() != SEGMENT_READY; ++i) {
+			if (i > 1000) {
+				throw std::runtime_error("Shared memory segment " + name + " is not initialized");
+			}
+			boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+		}
+	}
+
+	if (header->magic != ringMagic || header->version != ringVersion
+			|| header->recordSize != sizeof(TransformRecord)) {
+		throw std::runtime_error("Shared memory segment " + name + " has an incompatible layout");
+	}
+	if (region.get_size() < segmentSize(header->capacity, header->staticCapacity)) {
+		throw std::runtime_error("Shared memory segment " + name + " is too small");
+	}
+	if (header->capacity != capacity || header->staticCapacity != staticCapacity) {
+		RSCWARN(logger,
+				"Using capacities " << header->capacity << "/" << header->staticCapacity << " of existing segment " << name);
+	}
+
+	slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(header) + sizeof(Header));
+	statics = reinterpret_cast<StaticSlot*>(reinterpret_cast<char*>(slots)
+			+ header->capacity * sizeof(Slot));
+}
+
+TransformRingShm::~TransformRingShm() {
+}
+
+void TransformRingShm::remove(const string& name) {
+	shared_memory_object::remove(name.c_str());
+}
+
+bool TransformRingShm::write(const Transform& transform, bool isStatic, boost::uint64_t writer) {
+	TransformRecord record;
+	if (!record.fromTransform(transform)) {
+		RSCWARN(logger, "Cannot store " << transform.getFrameChild() << ", name too long");
+		return false;
+	}
+	if (isStatic && !writeStatic(record, writer)) {
+		return false;
+	}
+
+	boost::uint64_t ticket = header->head.fetch_add(1);
+	Slot& slot = slots[ticket % header->capacity];
+
+	// wait for the writer currently holding this slot, give up if a newer
+	// ticket already took it
+	const boost::uint64_t claim = 2 * boost::uint64_t(getpid()) + 1;
+	boost::uint64_t current = slot.sequence.load(boost::memory_order_acquire);
+	boost::posix_time::ptime deadline;
+	for (;;) {
+		if (current % 2 == 0) {
+			if (current > 2 * ticket) {
+				return true;
+			}
+			if (slot.sequence.compare_exchange_weak(current, claim, boost::memory_order_acquire)) {
+				break;
+			}
+			continue;
+		}
+		if (deadline.is_special()) {
+			deadline = now() + holdTimeout;
+		} else if (now() > deadline) {
+			boost::uint32_t holder = boost::uint32_t(current / 2);
+			if (!terminated(holder)) {
+				// readers skip the ticket after their pending timeout
+				RSCWARN(logger, "Dropping transform " << ticket << ", slot is held by process "
+						<< holder);
+				return false;
+			}
+			if (slot.sequence.compare_exchange_strong(current, claim,
+					boost::memory_order_acquire)) {
+				RSCWARN(logger, "Taking over slot from terminated process " << holder);
+				break;
+			}
+			continue;
+		}
+		boost::this_thread::yield();
+		current = slot.sequence.load(boost::memory_order_acquire);
+	}
+	boost::atomic_thread_fence(boost::memory_order_release);
+	slot.writer = writer;
+	slot.isStatic = isStatic;
+	memcpy(&slot.record, &record, sizeof(TransformRecord));
+	slot.sequence.store(2 * ticket + 2, boost::memory_order_release);
+
+	wake();
+	return true;
+}
+
+bool TransformRingShm::writeStatic(const TransformRecord& record, boost::uint64_t writer) {
+	// writers of the table are serialized, readers use the seqlocks
+	if (!lockStatics()) {
+		return false;
+	}
+
+	bool stored = false;
+	boost::uint32_t count = header->staticCount.load();
+	boost::uint32_t index = 0;
+	for (; index < count; ++index) {
+		if (strncmp(statics[index].record.child, record.child, TransformRecord::nameSize) == 0) {
+			break;
+		}
+	}
+	if (index < header->staticCapacity) {
+		StaticSlot& slot = statics[index];
+		slot.sequence.fetch_add(1, boost::memory_order_acquire);
+		boost::atomic_thread_fence(boost::memory_order_release);
+		slot.writer = writer;
+		memcpy(&slot.record, &record, sizeof(TransformRecord));
+		slot.sequence.fetch_add(1, boost::memory_order_release);
+		if (index == count) {
+			header->staticCount.store(count + 1);
+		}
+		stored = true;
+	} else {
+		RSCERROR(logger, "Static table of " << name << " is full");
+	}
+
+	header->staticLock.store(0, boost::memory_order_release);
+	return stored;
+}
+
+bool TransformRingShm::lockStatics() {
+	const boost::uint32_t pid = getpid();
+	boost::posix_time::ptime deadline = now() + holdTimeout;
+	boost::uint32_t current = 0;
+	while (!header->staticLock.compare_exchange_weak(current, pid, boost::memory_order_acquire)) {
+		if (current == 0) {
+			continue;
+		}
+		if (now() < deadline) {
+			boost::this_thread::yield();
+			current = 0;
+			continue;
+		}
+		if (!terminated(current)) {
+			RSCERROR(logger, "Static table of " << name << " is locked by process " << current);
+			return false;
+		}
+		if (header->staticLock.compare_exchange_strong(current, pid, boost::memory_order_acquire)) {
+			RSCWARN(logger, "Taking over static table of " << name << " from terminated process "
+					<< current);
+			repairStatics();
+			return true;
+		}
+		current = 0;
+	}
+	return true;
+}
+
+void TransformRingShm::repairStatics() {
+	// a slot the terminated writer left odd holds a torn record
+	boost::uint32_t count = std::min(header->staticCount.load() + 1, header->staticCapacity);
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		StaticSlot& slot = statics[i];
+		if (slot.sequence.load() % 2 == 1) {
+			memset(&slot.record, 0, sizeof(TransformRecord));
+			slot.sequence.fetch_add(1, boost::memory_order_release);
+		}
+	}
+}
+
+boost::uint64_t TransformRingShm::getHead() const {
+	return header->head.load(boost::memory_order_acquire);
+}
+
+TransformRingShm::ReadResult TransformRingShm::read(boost::uint64_t ticket, Entry& entry) const {
+	const Slot& slot = slots[ticket % header->capacity];
+	boost::uint64_t before = slot.sequence.load(boost::memory_order_acquire);
+	if (before % 2 == 1 || before < 2 * ticket + 2) {
+		return READ_PENDING;
+	}
+	if (before > 2 * ticket + 2) {
+		return READ_OVERRUN;
+	}
+	entry.writer = slot.writer;
+	entry.isStatic = slot.isStatic != 0;
+	memcpy(&entry.record, &slot.record, sizeof(TransformRecord));
+	boost::atomic_thread_fence(boost::memory_order_acquire);
+	if (slot.sequence.load(boost::memory_order_relaxed) != before) {
+		return READ_OVERRUN;
+	}
+	return READ_OK;
+}
+
+void TransformRingShm::readStatics(vector<Entry>& entries) const {
+	boost::uint32_t count = std::min(header->staticCount.load(), header->staticCapacity);
+	entries.reserve(entries.size() + count);
+	Entry entry;
+	entry.isStatic = true;
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		const StaticSlot& slot = statics[i];
+		bool copied = false;
+		boost::posix_time::ptime deadline;
+		for (;;) {
+			boost::uint32_t before = slot.sequence.load(boost::memory_order_acquire);
+			if (before % 2 == 1) {
+				// left odd by a terminated writer until the table is taken over
+				if (deadline.is_special()) {
+					deadline = now() + holdTimeout;
+				} else if (now() > deadline) {
+					break;
+				}
+				boost::this_thread::yield();
+				continue;
+			}
+			entry.writer = slot.writer;
+			memcpy(&entry.record, &slot.record, sizeof(TransformRecord));
+			boost::atomic_thread_fence(boost::memory_order_acquire);
+			if (slot.sequence.load(boost::memory_order_relaxed) == before) {
+				copied = true;
+				break;
+			}
+		}
+		// repaired slots are empty
+		if (copied && entry.record.child[0] != '\0') {
+			entries.push_back(entry);
+		}
+	}
+}
+
+void TransformRingShm::wait(boost::uint64_t head,
+		const boost::posix_time::time_duration& timeout) const {
+#ifdef __linux__
+	boost::uint32_t word = header->futexWord.load(boost::memory_order_acquire);
+	if (getHead() != head) {
+		return;
+	}
+	header->waiters.fetch_add(1);
+	struct timespec ts;
+	ts.tv_sec = timeout.total_seconds();
+	ts.tv_nsec = (timeout.total_microseconds() % 1000000) * 1000;
+	// not FUTEX_PRIVATE_FLAG, the word is shared between processes
+	syscall(SYS_futex, reinterpret_cast<int*>(&header->futexWord), FUTEX_WAIT, word, &ts, NULL,
+			0);
+	header->waiters.fetch_sub(1);
+#else
+	boost::posix_time::ptime deadline = now() + timeout;
+	while (getHead() == head && now() < deadline) {
+		boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+	}
+#endif
+}
+
+void TransformRingShm::waitWritten(boost::uint64_t ticket,
+		const boost::posix_time::time_duration& timeout) const {
+	const Slot& slot = slots[ticket % header->capacity];
+#ifdef __linux__
+	// every completed write changes the word, checked after loading it
+	boost::uint32_t word = header->futexWord.load(boost::memory_order_acquire);
+	boost::uint64_t sequence = slot.sequence.load(boost::memory_order_acquire);
+	if (sequence % 2 == 0 && sequence >= 2 * ticket + 2) {
+		return;
+	}
+	header->waiters.fetch_add(1);
+	struct timespec ts;
+	ts.tv_sec = timeout.total_seconds();
+	ts.tv_nsec = (timeout.total_microseconds() % 1000000) * 1000;
+	syscall(SYS_futex, reinterpret_cast<int*>(&header->futexWord), FUTEX_WAIT, word, &ts, NULL,
+			0);
+	header->waiters.fetch_sub(1);
+#else
+	boost::posix_time::ptime deadline = now() + timeout;
+	for (;;) {
+		boost::uint64_t sequence = slot.sequence.load(boost::memory_order_acquire);
+		if ((sequence % 2 == 0 && sequence >= 2 * ticket + 2) || now() >= deadline) {
+			return;
+		}
+		boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+	}
+#endif
+}
+
+void TransformRingShm::wake() {
+	header->futexWord.fetch_add(1, boost::memory_order_release);
+#ifdef __linux__
+	if (header->waiters.load() > 0) {
+		syscall(SYS_futex, reinterpret_cast<int*>(&header->futexWord), FUTEX_WAKE, INT_MAX, NULL,
+				NULL, 0);
+	}
+#endif
+}
+
+boost::uint32_t TransformRingShm::getCapacity() const {
+	return header->capacity;
+}
+
+boost::uint32_t TransformRingShm::getStaticCapacity() const {
+	return header->staticCapacity;
+}
+
+}  // namespace rct
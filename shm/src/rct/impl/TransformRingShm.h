@@ -0,0 +1,113 @@
+/*
+ * TransformRingShm.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/impl/TransformRecord.h>
+#include <rsc/logging/Logger.h>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <vector>
+
+namespace rct {
+
+/**
+ * A ring of TransformRecords in a named shared memory segment, written and
+ * read by any number of processes on one host.
+ *
+ * Writers claim consecutive tickets. The slot of a ticket is protected by a
+ * seqlock, so readers never block writers: a reader copies the record and
+ * detects by the slot's sequence counter whether it was overwritten
+ * meanwhile. Readers that fall behind by more than the capacity lose the
+ * overwritten records. A writer waits only shortly for the writer of the
+ * previous lap of its slot: it takes the slot over if that process
+ * terminated and drops its record otherwise. A claimed slot holds the pid
+ * of its writer instead of the ticket, so the holder is known as soon as
+ * the slot is taken. The static table is locked by pid and taken over the
+ * same way.
+ *
+ * Static transforms are additionally kept in a table indexed by child frame
+ * (also seqlock protected), from which late joining readers can fetch them.
+ *
+ * Waiting readers are woken through a futex on Linux and poll otherwise.
+ *
+ * The first process creating the segment determines its capacities. The
+ * segment persists until removed with remove().
+ */
+class TransformRingShm: public boost::noncopyable {
+public:
+	typedef boost::shared_ptr<TransformRingShm> Ptr;
+
+	enum ReadResult {
+		/** the record was copied */
+		READ_OK,
+		/** the ticket was not written (completely) yet */
+		READ_PENDING,
+		/** the slot was overwritten by a newer ticket */
+		READ_OVERRUN
+	};
+
+	class Entry {
+	public:
+		TransformRecord record;
+		bool isStatic;
+		boost::uint64_t writer;
+	};
+
+	TransformRingShm(const std::string& name, boost::uint32_t capacity,
+			boost::uint32_t staticCapacity);
+	virtual ~TransformRingShm();
+
+	/** \return false if the transform cannot be stored (name too long, static table full,
+	 * slot or static table held by a stalled writer) */
+	bool write(const Transform& transform, bool isStatic, boost::uint64_t writer);
+
+	/** \brief The next ticket to be claimed by a writer */
+	boost::uint64_t getHead() const;
+
+	ReadResult read(boost::uint64_t ticket, Entry& entry) const;
+
+	/** \brief Copy all entries of the static table */
+	void readStatics(std::vector<Entry>& entries) const;
+
+	/** \brief Block until the head moved beyond the given ticket or the timeout expired */
+	void wait(boost::uint64_t head, const boost::posix_time::time_duration& timeout) const;
+
+	/** \brief Block until a claimed ticket was written, another write completed or the
+	 * timeout expired */
+	void waitWritten(boost::uint64_t ticket,
+			const boost::posix_time::time_duration& timeout) const;
+
+	boost::uint32_t getCapacity() const;
+	boost::uint32_t getStaticCapacity() const;
+
+	static void remove(const std::string& name);
+
+	struct Header;
+	struct Slot;
+	struct StaticSlot;
+
+private:
+	std::string name;
+	boost::interprocess::shared_memory_object shm;
+	boost::interprocess::mapped_region region;
+	Header* header;
+	Slot* slots;
+	StaticSlot* statics;
+
+	static rsc::logging::LoggerPtr logger;
+
+	bool writeStatic(const TransformRecord& record, boost::uint64_t writer);
+	bool lockStatics();
+	void repairStatics();
+	void wake();
+};
+
+}  // namespace rct
@@ -0,0 +1,247 @@
+/*
+ * TransformerShm.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#include "TransformerShm.h"
+#include <rct/impl/TransformerCoreRegistry.h>
+#include <tf2/exceptions.h>
+#include <sstream>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformerShm::logger = rsc::logging::Logger::getLogger(
+		"rct.shm.TransformerShm");
+
+// readers are not notified of changes and poll the buffer while requests are pending
+static const boost::posix_time::time_duration pollInterval = boost::posix_time::milliseconds(1);
+
+static TransformerCore::Ptr createCore(const TransformerConfig& config, bool& attached) {
+	string mode = boost::algorithm::to_upper_copy(
+			config.getCoreOption<string>("shm", "mode", "READER"));
+	if (mode != "READER" && mode != "WRITER") {
+		throw std::invalid_argument(
+				boost::str(boost::format("Value `%1%' does not name a shared core mode.") % mode));
+	}
+	TransformerShm::Ptr core(
+			new TransformerShm(config.getCoreOption<string>("shm", "name", "rct_buffer"),
+					config.getCoreOption<boost::uint32_t>("shm", "frames", 256),
+					config.getCoreOption<boost::uint32_t>("shm", "samples", 2048),
+					mode == "WRITER"));
+	// readers are filled by the writing process
+	attached = !core->isWriter();
+	return core;
+}
+
+void registerShmCore() {
+	TransformerCoreRegistry::add("SHM", &createCore);
+}
+
+TransformerShm::TransformerShm(const string& name, boost::uint32_t frameCapacity,
+		boost::uint32_t sampleCapacity, bool writer) :
+		buffer(name, frameCapacity, sampleCapacity, writer), resolver(buffer), running(true) {
+	if (!writer) {
+		watcher = boost::thread(&TransformerShm::watch, this);
+	}
+}
+
+TransformerShm::~TransformerShm() {
+	{
+		boost::mutex::scoped_lock lock(inprogressMutex);
+		running = false;
+		inprogressCondition.notify_all();
+	}
+	if (watcher.joinable()) {
+		watcher.join();
+	}
+}
+
+void TransformerShm::clear() {
+	buffer.clear();
+}
+
+bool TransformerShm::setTransform(const Transform& transform, bool is_static) {
+	bool result = buffer.write(transform, is_static);
+	changed();
+	return result;
+}
+
+bool TransformerShm::setTransforms(const vector<Transform>& transforms, bool is_static) {
+	bool result = true;
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		result = buffer.write(*it, is_static) && result;
+	}
+	changed();
+	return result;
+}
+
+Transform TransformerShm::lookupTransform(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time) const {
+	return resolver.lookupTransform(target_frame, source_frame, time);
+}
+
+Transform TransformerShm::lookupTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame) const {
+	return resolver.lookupTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame);
+}
+
+TransformerShm::FuturePtr TransformerShm::requestTransform(const string& target_frame,
+		const string& source_frame, const boost::posix_time::ptime& time) {
+
+	Request request(target_frame, source_frame, time);
+
+	boost::mutex::scoped_lock lock(inprogressMutex);
+	map<Request, FuturePtr>::iterator pending = requestsInProgress.find(request);
+	if (pending != requestsInProgress.end()) {
+		RSCTRACE(logger, "Identical request already pending. Share its result.");
+		return pending->second;
+	}
+
+	FuturePtr result(new FutureType());
+	try {
+		result->set(lookupTransform(target_frame, source_frame, time));
+		RSCTRACE(logger, "Lookup possible before request applies. Take shortcut.");
+	} catch (tf2::LookupException &e) {
+		RSCTRACE(logger, "Lookup NOT possible before request applies. Register request.");
+		requestsInProgress.insert(make_pair(request, result));
+		inprogressCondition.notify_all();
+	} catch (tf2::ExtrapolationException &e) {
+		RSCTRACE(logger, "Lookup NOT possible before request applies. Register request.");
+		requestsInProgress.insert(make_pair(request, result));
+		inprogressCondition.notify_all();
+	}
+	return result;
+}
+
+void TransformerShm::changed() {
+	boost::mutex::scoped_lock lock(inprogressMutex);
+	map<Request, FuturePtr>::iterator it = requestsInProgress.begin();
+	while (it != requestsInProgress.end()) {
+		try {
+			Transform t = lookupTransform(it->first.target_frame, it->first.source_frame,
+					it->first.time);
+			it->second->set(t);
+			requestsInProgress.erase(it++);
+			continue;
+		} catch (tf2::LookupException &e) {
+			RSCTRACE(logger, "Not yet transformable ");
+		} catch (tf2::ExtrapolationException &e) {
+			RSCTRACE(logger, "Not yet transformable ");
+		}
+		++it;
+	}
+}
+
+void TransformerShm::watch() {
+	boost::uint64_t generation = buffer.getGeneration();
+	while (running) {
+		{
+			boost::mutex::scoped_lock lock(inprogressMutex);
+			while (running && requestsInProgress.empty()) {
+				inprogressCondition.wait(lock);
+			}
+		}
+		boost::uint64_t current = buffer.getGeneration();
+		if (current != generation) {
+			generation = current;
+			changed();
+		}
+		boost::this_thread::sleep(pollInterval);
+	}
+}
+
+bool TransformerShm::canTransform(const string& target_frame, const string& source_frame,
+		const boost::posix_time::ptime& time, string* error_msg) const {
+	return resolver.canTransform(target_frame, source_frame, time, error_msg);
+}
+
+bool TransformerShm::canTransform(const string& target_frame,
+		const boost::posix_time::ptime& target_time, const string& source_frame,
+		const boost::posix_time::ptime& source_time, const string& fixed_frame,
+		string* error_msg) const {
+	return resolver.canTransform(target_frame, target_time, source_frame, source_time,
+			fixed_frame, error_msg);
+}
+
+vector<string> TransformerShm::getFrameStrings() const {
+	return buffer.getFrameNames();
+}
+
+bool TransformerShm::frameExists(const string& frame_id_str) const {
+	return buffer.frameExists(frame_id_str);
+}
+
+string TransformerShm::getParent(const string& frame_id,
+		const boost::posix_time::ptime& time) const {
+	return resolver.getParent(frame_id, time);
+}
+
+string TransformerShm::allFramesAsDot() const {
+	stringstream dot;
+	dot << "digraph G {" << endl;
+	vector<string> frames = buffer.getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			dot << "\"" << parent << "\" -> \"" << *it << "\";" << endl;
+		}
+	}
+	dot << "}";
+	return dot.str();
+}
+
+string TransformerShm::allFramesAsYAML() const {
+	stringstream yaml;
+	vector<string> frames = buffer.getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			yaml << *it << ": " << endl;
+			yaml << "  parent: '" << parent << "'" << endl;
+		}
+	}
+	return yaml.str();
+}
+
+string TransformerShm::allFramesAsString() const {
+	stringstream text;
+	vector<string> frames = buffer.getFrameNames();
+	vector<string>::const_iterator it;
+	for (it = frames.begin(); it != frames.end(); ++it) {
+		string parent = getParent(*it, boost::posix_time::ptime());
+		if (!parent.empty()) {
+			text << "Frame " << *it << " exists with parent " << parent << "." << endl;
+		}
+	}
+	return text.str();
+}
+
+void TransformerShm::newTransformAvailable(const Transform& transform, bool isStatic) {
+	setTransform(transform, isStatic);
+}
+
+void TransformerShm::newTransformsAvailable(const vector<Transform>& transforms, bool isStatic) {
+	setTransforms(transforms, isStatic);
+}
+
+bool TransformerShm::isWriter() const {
+	return buffer.isWriter();
+}
+
+void TransformerShm::printContents(ostream& stream) const {
+	stream << "backend = shared memory";
+	stream << ", mode = " << (buffer.isWriter() ? "writer" : "reader");
+	stream << ", frameCapacity = " << buffer.getFrameCapacity();
+	stream << ", sampleCapacity = " << buffer.getSampleCapacity();
+}
+
+}  // namespace rct
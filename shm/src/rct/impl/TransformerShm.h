@@ -0,0 +1,119 @@
+/*
+ * TransformerShm.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: openbase
+ */
+
+#pragma once
+
+#include <rct/impl/TransformerCore.h>
+#include <rct/impl/TransformChainResolver.h>
+#include "TransformBufferShm.h"
+#include <rsc/logging/Logger.h>
+#include <boost/atomic.hpp>
+#include <map>
+
+namespace rct {
+
+/**
+ * Makes the shared memory core available as core type `SHM'. Called by the
+ * factory, a static registrar in this library would be dropped by linkers
+ * using --as-needed when nothing else references the library.
+ */
+void registerShmCore();
+
+/**
+ * Core keeping its transforms in a TransformBufferShm shared by all
+ * processes of a host.
+ *
+ * One process (usually a dedicated daemon) creates the core as writer and
+ * feeds it from a communicator. All other processes attach as readers:
+ * they neither receive nor store transforms themselves, their lookups are
+ * resolved directly on the shared buffer. Pending requests of readers are
+ * re-evaluated whenever the writer changed the buffer.
+ */
+class TransformerShm: public TransformerCore {
+public:
+	typedef boost::shared_ptr<TransformerShm> Ptr;
+
+	TransformerShm(const std::string& name, boost::uint32_t frameCapacity,
+			boost::uint32_t sampleCapacity, bool writer);
+	virtual ~TransformerShm();
+
+	virtual void clear();
+
+	virtual bool setTransform(const Transform& transform, bool is_static = false);
+	virtual bool setTransforms(const std::vector<Transform>& transforms, bool is_static = false);
+
+	virtual Transform lookupTransform(const std::string& target_frame,
+			const std::string& source_frame, const boost::posix_time::ptime& time) const;
+	virtual Transform lookupTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame) const;
+
+	virtual FuturePtr requestTransform(const std::string& target_frame,
+			const std::string& source_frame, const boost::posix_time::ptime& time);
+
+	virtual bool canTransform(const std::string& target_frame, const std::string& source_frame,
+			const boost::posix_time::ptime& time, std::string* error_msg = NULL) const;
+	virtual bool canTransform(const std::string& target_frame,
+			const boost::posix_time::ptime& target_time, const std::string& source_frame,
+			const boost::posix_time::ptime& source_time, const std::string& fixed_frame,
+			std::string* error_msg = NULL) const;
+
+	virtual std::vector<std::string> getFrameStrings() const;
+	virtual bool frameExists(const std::string& frame_id_str) const;
+	virtual std::string getParent(const std::string& frame_id,
+			const boost::posix_time::ptime& time) const;
+
+	virtual std::string allFramesAsDot() const;
+	virtual std::string allFramesAsYAML() const;
+	virtual std::string allFramesAsString() const;
+
+	virtual void newTransformAvailable(const Transform& transform, bool isStatic);
+	virtual void newTransformsAvailable(const std::vector<Transform>& transforms, bool isStatic);
+
+	/** \brief false if the core was attached read-only */
+	bool isWriter() const;
+
+	void printContents(std::ostream& stream) const;
+
+private:
+	class Request {
+	public:
+		std::string target_frame;
+		std::string source_frame;
+		boost::posix_time::ptime time;
+		Request(const std::string& target_frame, const std::string& source_frame,
+				const boost::posix_time::ptime& time) :
+				target_frame(target_frame), source_frame(source_frame), time(time) {
+		}
+		bool operator<(const Request &r) const {
+			if (time != r.time) {
+				return time < r.time;
+			}
+			if (target_frame != r.target_frame) {
+				return target_frame < r.target_frame;
+			}
+			return source_frame < r.source_frame;
+		}
+	};
+
+	TransformBufferShm buffer;
+	TransformChainResolver resolver;
+
+	boost::mutex inprogressMutex;
+	boost::condition_variable inprogressCondition;
+	// identical pending requests share one future
+	std::map<Request, FuturePtr> requestsInProgress;
+	boost::atomic<bool> running;
+	boost::thread watcher;
+
+	static rsc::logging::LoggerPtr logger;
+
+	void changed();
+	void watch();
+};
+
+}  // namespace rct